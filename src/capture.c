@@ -0,0 +1,182 @@
+/**
+ * capture.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/capture.h"
+
+#if (SUPPRESS_EXTIO)
+
+bool capture_init(char* path, VideoFormat format, int width, int height) {
+  return false;
+}
+
+void capture_submitFrame(uint32_t* bmp) {}
+
+void capture_finish(void) {}
+
+bool capture_isActive(void) {
+  return false;
+}
+
+uint32_t capture_droppedFrames(void) {
+  return 0;
+}
+
+#else
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+// single-producer, single-consumer ring
+// the emulation thread only advances captureHead, the writer only advances captureTail
+uint32_t* captureRing[CAPTURE_RING_SIZE];
+atomic_uint captureHead;
+atomic_uint captureTail;
+atomic_bool captureRunning;
+uint32_t captureDropped = 0;
+uint32_t captureWritten = 0;
+uint32_t captureFailed = 0;
+bool captureActive = false;
+uint8_t* captureEncoded = NULL;
+
+pthread_t captureThread;
+FILE* captureFile = NULL;
+char capturePath[FILEIO_MAX_PATH_SIZE];
+VideoFormat captureFormat;
+int captureWidth;
+int captureHeight;
+
+void capture_release(void) {
+  if (captureFile != NULL) {
+    fclose(captureFile);
+    captureFile = NULL;
+  }
+  for (int i = 0; i < CAPTURE_RING_SIZE; i++) {
+    free(captureRing[i]);
+    captureRing[i] = NULL;
+  }
+  free(captureEncoded);
+  captureEncoded = NULL;
+}
+
+void* capture_writerLoop(void* arg) {
+  uint8_t* encoded = captureEncoded;
+
+  while (true) {
+    unsigned int tail = atomic_load_explicit(&captureTail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&captureHead, memory_order_acquire);
+
+    if (tail == head) {
+      // only stop once every queued frame has been written
+      if (!atomic_load(&captureRunning)) break;
+      usleep(CAPTURE_IDLE_US);
+      continue;
+    }
+
+    uint32_t size = video_encodeFrame(captureFormat, captureRing[tail % CAPTURE_RING_SIZE], captureWidth, captureHeight, encoded);
+    atomic_store_explicit(&captureTail, tail + 1, memory_order_release);
+
+    bool didWrite = false;
+    if (captureFormat == VIDEO_PPM) {
+      // PPM captures are written as a numbered sequence in a directory
+      char framePath[FILEIO_MAX_PATH_SIZE + 16];
+      sprintf(framePath, "%s/%06u.ppm", capturePath, captureWritten + captureFailed);
+      FILE* fp = fopen(framePath, "wb");
+      if (fp != NULL) {
+        didWrite = fwrite(encoded, 1, size, fp) == size;
+        didWrite &= (fclose(fp) == 0);
+      }
+    } else {
+      didWrite = fwrite(encoded, 1, size, captureFile) == size;
+    }
+
+    if (didWrite) {
+      captureWritten += 1;
+    } else {
+      captureFailed += 1;
+    }
+  }
+
+  return NULL;
+}
+
+bool capture_init(char* path, VideoFormat format, int width, int height) {
+  strncpy(capturePath, path, FILEIO_MAX_PATH_SIZE - 1);
+  capturePath[FILEIO_MAX_PATH_SIZE - 1] = '\0';
+  captureFormat = format;
+  captureWidth = width;
+  captureHeight = height;
+
+  if (format != VIDEO_PPM) {
+    captureFile = fopen(path, "wb");
+    if (captureFile == NULL) return false;
+    video_writeStreamHeader(captureFile, format, width, height);
+  }
+
+  // the writer can't report a failed allocation, so everything is allocated here
+  bool didAllocate = true;
+  for (int i = 0; i < CAPTURE_RING_SIZE; i++) {
+    captureRing[i] = malloc(sizeof(uint32_t) * width * height);
+    didAllocate &= (captureRing[i] != NULL);
+  }
+  captureEncoded = malloc(video_frameSize(format, width, height));
+  didAllocate &= (captureEncoded != NULL);
+  if (!didAllocate) {
+    capture_release();
+    return false;
+  }
+
+  atomic_init(&captureHead, 0);
+  atomic_init(&captureTail, 0);
+  atomic_init(&captureRunning, true);
+
+  if (pthread_create(&captureThread, NULL, &capture_writerLoop, NULL) != 0) {
+    capture_release();
+    return false;
+  }
+
+  captureActive = true;
+  atexit(&capture_finish);
+  return true;
+}
+
+void capture_submitFrame(uint32_t* bmp) {
+  if (!captureActive) return;
+
+  unsigned int head = atomic_load_explicit(&captureHead, memory_order_relaxed);
+  unsigned int tail = atomic_load_explicit(&captureTail, memory_order_acquire);
+
+  // never wait on the writer, just drop the frame if it has fallen behind
+  if (head - tail >= CAPTURE_RING_SIZE) {
+    captureDropped += 1;
+    return;
+  }
+
+  memcpy(captureRing[head % CAPTURE_RING_SIZE], bmp, sizeof(uint32_t) * captureWidth * captureHeight);
+  atomic_store_explicit(&captureHead, head + 1, memory_order_release);
+}
+
+void capture_finish(void) {
+  if (!captureActive) return;
+  captureActive = false;
+
+  atomic_store(&captureRunning, false);
+  pthread_join(captureThread, NULL);
+  capture_release();
+
+  fprintf(stderr, "CAPTURE: %u frames written, %u dropped, %u failed\n", captureWritten, captureDropped, captureFailed);
+}
+
+bool capture_isActive(void) {
+  return captureActive;
+}
+
+uint32_t capture_droppedFrames(void) {
+  return captureDropped;
+}
+
+#endif
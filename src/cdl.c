@@ -0,0 +1,106 @@
+/**
+ * cdl.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/cdl.h"
+
+bool isCodeDataLogging = false;
+uint8_t* cdlLog = NULL;
+uint32_t cdlPrgSize = 0;
+uint32_t cdlChrSize = 0;
+char cdlPath[FILEIO_MAX_PATH_SIZE];
+
+void cdl_markCode(uint16_t addr, uint8_t length) {
+  cdlLog[(addr - 0x8000) & (cdlPrgSize - 1)] |= CDL_CODE | CDL_OPCODE;
+  for (uint8_t i = 1; i < length; i++) {
+    cdlLog[(uint16_t) (addr + i - 0x8000) & (cdlPrgSize - 1)] |= CDL_CODE;
+  }
+}
+
+void cdl_markData(uint16_t addr) {
+  cdlLog[(addr - 0x8000) & (cdlPrgSize - 1)] |= CDL_DATA;
+}
+
+uint8_t cdl_flags(uint16_t addr) {
+  if (cdlLog == NULL) return 0;
+  return cdlLog[(addr - 0x8000) & (cdlPrgSize - 1)];
+}
+
+bool cdl_isLoaded(void) {
+  return cdlLog != NULL;
+}
+
+#if (SUPPRESS_EXTIO)
+
+bool cdl_load(uint64_t romHash, uint32_t prgSize, uint32_t chrSize) {
+  return true;
+}
+
+bool cdl_startLogging(void) {
+  return false;
+}
+
+void cdl_finish(void) {}
+
+#else
+
+bool cdl_load(uint64_t romHash, uint32_t prgSize, uint32_t chrSize) {
+  sprintf(cdlPath, CDL_PATH, (unsigned long long) romHash);
+  cdlPrgSize = prgSize;
+  cdlChrSize = chrSize;
+
+  uint8_t* data;
+  int size = fileio_readFileAsBinary(cdlPath, &data);
+  if (size == -1) return true;
+
+  // a log of a different size came from a different dump, so it's ignored
+  if (size == prgSize + chrSize) {
+    cdlLog = calloc(prgSize + chrSize, sizeof(uint8_t));
+    if (cdlLog == NULL) {
+      free(data);
+      return false;
+    }
+    // CHR flags are never logged, so they're written back as zeros
+    memcpy(cdlLog, data, prgSize);
+  }
+  free(data);
+  return true;
+}
+
+bool cdl_startLogging(void) {
+  if (cdlLog == NULL) {
+    cdlLog = calloc(cdlPrgSize + cdlChrSize, sizeof(uint8_t));
+    if (cdlLog == NULL) return false;
+  }
+  isCodeDataLogging = true;
+  atexit(&cdl_finish);
+  return true;
+}
+
+void cdl_finish(void) {
+  if (!isCodeDataLogging) return;
+
+  FILE* fp = fopen(cdlPath, "wb");
+  if (fp == NULL) {
+    fprintf(stderr, "CDL: unable to write %s\n", cdlPath);
+    return;
+  }
+  fwrite(cdlLog, sizeof(uint8_t), cdlPrgSize + cdlChrSize, fp);
+  fclose(fp);
+
+  uint32_t logged = 0;
+  uint32_t code = 0;
+  uint32_t data = 0;
+  for (uint32_t i = 0; i < cdlPrgSize; i++) {
+    logged += (cdlLog[i] & (CDL_CODE | CDL_DATA)) != 0;
+    code += (cdlLog[i] & CDL_CODE) != 0;
+    data += (cdlLog[i] & CDL_DATA) != 0;
+  }
+  fprintf(stderr, "CDL: %u of %u PRG bytes logged (%u code, %u data) to %s\n",
+    logged, cdlPrgSize, code, data, cdlPath);
+}
+
+#endif
@@ -10,7 +10,19 @@
 PlatformConfig CONFIG_PLATFORM;
 DisplayConfig CONFIG_DISPLAY;
 CpuConfig CONFIG_CPU;
-DebugConfig CONFIG_DEBUG;
+// the flight recorder is only useful if it was already running when things went wrong
+DebugConfig CONFIG_DEBUG = { .shouldRecordFlight = !MINIMIZE_MEMORY };
+HeadlessConfig CONFIG_HEADLESS;
+CaptureConfig CONFIG_CAPTURE;
+ShmConfig CONFIG_SHM;
+RewindConfig CONFIG_REWIND;
+RunAheadConfig CONFIG_RUNAHEAD;
+FastForwardConfig CONFIG_FASTFORWARD;
+BootConfig CONFIG_BOOT;
+MovieConfig CONFIG_MOVIE;
+HashConfig CONFIG_HASH;
+GoldenConfig CONFIG_GOLDEN;
+TimelineConfig CONFIG_TIMELINE;
 
 #if (SUPPRESS_EXTIO)
 
@@ -37,7 +49,37 @@ bool config_init(char* path) {
       CONFIG_DISPLAY.screens = 1;
     }
 
-    config_print();
+    // filters produce a fixed factor, so the scale has to agree with it
+    if (CONFIG_DISPLAY.filter != FILTER_NONE && CONFIG_DISPLAY.scale != (int) CONFIG_DISPLAY.filter) {
+#if (!SUPPRESS_EXTIO)
+      printf("CONFIGURATION ERROR: DISPLAY_filter requires DISPLAY_scale = %d\n", (int) CONFIG_DISPLAY.filter);
+#endif
+      exit(1);
+    }
+
+    if (CONFIG_MOVIE.recordPath[0] != '\0' && CONFIG_MOVIE.replayPath[0] != '\0') {
+#if (!SUPPRESS_EXTIO)
+      printf("CONFIGURATION ERROR: MOVIE_record and MOVIE_replay cannot both be set\n");
+#endif
+      exit(1);
+    }
+
+    // run-ahead leaves the predicted frame in the bitmap, so hashes would not cover the real one
+    if ((CONFIG_HASH.logPath[0] != '\0' || CONFIG_HASH.comparePath[0] != '\0') && CONFIG_RUNAHEAD.frames > 0) {
+#if (!SUPPRESS_EXTIO)
+      printf("CONFIGURATION ERROR: HASH_log and HASH_compare cannot be used with RUNAHEAD_frames\n");
+#endif
+      exit(1);
+    }
+
+    // golden runs bring their own input and produce no video
+    if (CONFIG_GOLDEN.listPath[0] != '\0' && (IO_LIBRARY != HEADLESS || CONFIG_HEADLESS.videoPath[0] != '\0' || CONFIG_HEADLESS.inputPath[0] != '\0')) {
+#if (!SUPPRESS_EXTIO)
+      printf("CONFIGURATION ERROR: GOLDEN_list requires a headless build without HEADLESS_videoPath or HEADLESS_inputPath\n");
+#endif
+      exit(1);
+    }
+
     return true;
   } else {
     return false;
@@ -56,18 +98,87 @@ void config_print(void) {
   printf("\nDISPLAY\n");
   printf("- Resolution: %d x %d\n", CONFIG_DISPLAY.width, CONFIG_DISPLAY.height);
   printf("- Scale: %d\n", CONFIG_DISPLAY.scale);
+  printf("- Filter: %s\n", CONFIG_DISPLAY.filter == FILTER_SCALE2X ? "Scale2x" : (CONFIG_DISPLAY.filter == FILTER_SCALE3X ? "Scale3x" : "none"));
 
   printf("\nCPU\n");
   printf("- Frequency: %ld Hz\n", CONFIG_CPU.frequency);
   printf("- Cache instructions? %s\n", CONFIG_CPU.shouldCacheInstructions ? "yes" : "no");
+  printf("- Skip idle loops? %s\n", CONFIG_CPU.shouldSkipIdleLoops ? "yes" : "no");
 
   printf("\nDEBUG\n");
   printf(" - Display performance stats? %s\n", CONFIG_DEBUG.shouldDisplayPerformance ? "yes" : "no");
   printf(" - Display debug screen? %s\n", CONFIG_DEBUG.shouldDisplayDebugScreen ? "yes" : "no");
   printf(" - Store instruction trace? %s\n", CONFIG_DEBUG.shouldTraceInstructions ? "yes" : "no");
+  printf(" - Trace format: %s\n", CONFIG_DEBUG.traceFormat == TRACE_BINARY ? "binary" : "text");
+  printf(" - Record flight? %s\n", CONFIG_DEBUG.shouldRecordFlight ? "yes" : "no");
+  printf(" - Profile guest code? %s\n", CONFIG_DEBUG.shouldProfile ? "yes" : "no");
+  printf(" - Count host events? %s\n", CONFIG_DEBUG.shouldCountHostEvents ? "yes" : "no");
+  printf(" - Log code/data? %s\n", CONFIG_DEBUG.shouldLogCodeData ? "yes" : "no");
   printf(" - Limit frequency? %s\n", CONFIG_DEBUG.shouldLimitFrequency ? "yes" : "no");
   printf(" - Debug CPU? %s\n", CONFIG_DEBUG.shouldDebugCPU ? "yes" : "no");
 
+  if (IO_LIBRARY == HEADLESS) {
+    printf("\nHEADLESS\n");
+    printf(" - Video output: %s\n", CONFIG_HEADLESS.videoPath[0] != '\0' ? CONFIG_HEADLESS.videoPath : "(none)");
+    printf(" - Video format: %s\n", CONFIG_HEADLESS.videoFormat == VIDEO_Y4M ? "Y4M" : "RGB");
+    printf(" - Input script: %s\n", CONFIG_HEADLESS.inputPath[0] != '\0' ? CONFIG_HEADLESS.inputPath : "(none)");
+    printf(" - Frame limit: %ld\n", CONFIG_HEADLESS.frameLimit);
+  }
+
+  if (CONFIG_CAPTURE.path[0] != '\0') {
+    printf("\nCAPTURE\n");
+    printf(" - Path: %s\n", CONFIG_CAPTURE.path);
+    printf(" - Format: %s\n", CONFIG_CAPTURE.format == VIDEO_PPM ? "PPM" : "Y4M");
+  }
+
+  if (CONFIG_SHM.name[0] != '\0') {
+    printf("\nSHARED MEMORY\n");
+    printf(" - Name: %s\n", CONFIG_SHM.name);
+  }
+
+  if (CONFIG_REWIND.bufferSize > 0) {
+    printf("\nREWIND\n");
+    printf(" - Buffer size: %ld KB\n", CONFIG_REWIND.bufferSize);
+  }
+
+  if (CONFIG_RUNAHEAD.frames > 0) {
+    printf("\nRUN-AHEAD\n");
+    printf(" - Frames: %d\n", CONFIG_RUNAHEAD.frames);
+  }
+
+  if (CONFIG_FASTFORWARD.multiplier > 1) {
+    printf("\nFAST-FORWARD\n");
+    printf(" - Multiplier: %dx\n", CONFIG_FASTFORWARD.multiplier);
+  }
+
+  if (CONFIG_BOOT.cacheFrames > 0) {
+    printf("\nBOOT CACHE\n");
+    printf(" - Frames: %d\n", CONFIG_BOOT.cacheFrames);
+  }
+
+  if (CONFIG_MOVIE.recordPath[0] != '\0' || CONFIG_MOVIE.replayPath[0] != '\0') {
+    printf("\nMOVIE\n");
+    printf(" - Record: %s\n", CONFIG_MOVIE.recordPath[0] != '\0' ? CONFIG_MOVIE.recordPath : "(none)");
+    printf(" - Replay: %s\n", CONFIG_MOVIE.replayPath[0] != '\0' ? CONFIG_MOVIE.replayPath : "(none)");
+  }
+
+  if (CONFIG_HASH.logPath[0] != '\0' || CONFIG_HASH.comparePath[0] != '\0') {
+    printf("\nHASH\n");
+    printf(" - Log: %s\n", CONFIG_HASH.logPath[0] != '\0' ? CONFIG_HASH.logPath : "(none)");
+    printf(" - Compare: %s\n", CONFIG_HASH.comparePath[0] != '\0' ? CONFIG_HASH.comparePath : "(none)");
+  }
+
+  if (CONFIG_GOLDEN.listPath[0] != '\0') {
+    printf("\nGOLDEN\n");
+    printf(" - List: %s\n", CONFIG_GOLDEN.listPath);
+    printf(" - Update? %s\n", CONFIG_GOLDEN.shouldUpdate ? "yes" : "no");
+  }
+
+  if (CONFIG_TIMELINE.path[0] != '\0') {
+    printf("\nTIMELINE\n");
+    printf(" - Path: %s\n", CONFIG_TIMELINE.path);
+  }
+
   printf("\n");
 #endif
 }
@@ -88,20 +199,96 @@ void config_parseSetting(char* line) {
     CONFIG_DISPLAY.height = atoi(val);
   } else if (!strcmp(arg, "DISPLAY_scale")) {
     CONFIG_DISPLAY.scale = atoi(val);
+  } else if (!strcmp(arg, "DISPLAY_filter")) {
+    if (!strcmp(val, "NONE")) {
+      CONFIG_DISPLAY.filter = FILTER_NONE;
+    } else if (!strcmp(val, "SCALE2X")) {
+      CONFIG_DISPLAY.filter = FILTER_SCALE2X;
+    } else if (!strcmp(val, "SCALE3X")) {
+      CONFIG_DISPLAY.filter = FILTER_SCALE3X;
+    } else {
+      config_throwInvalidConfigVal(arg, val);
+    }
   } else if (!strcmp(arg, "CPU_frequency")) {
     CONFIG_CPU.frequency = atoi(val);
   } else if (!strcmp(arg, "CPU_shouldCacheInstructions")) {
     CONFIG_CPU.shouldCacheInstructions = config_boolFromString(arg, val);
+  } else if (!strcmp(arg, "CPU_shouldSkipIdleLoops")) {
+    CONFIG_CPU.shouldSkipIdleLoops = config_boolFromString(arg, val);
   } else if (!strcmp(arg, "DEBUG_shouldDisplayPerformance")) {
     CONFIG_DEBUG.shouldDisplayPerformance = config_boolFromString(arg, val);
   } else if (!strcmp(arg, "DEBUG_shouldDisplayDebugScreen")) {
     CONFIG_DEBUG.shouldDisplayDebugScreen = config_boolFromString(arg, val);
   } else if (!strcmp(arg, "DEBUG_shouldTraceInstructions")) {
     CONFIG_DEBUG.shouldTraceInstructions = config_boolFromString(arg, val);
+  } else if (!strcmp(arg, "DEBUG_traceFormat")) {
+    if (!strcmp(val, "TEXT")) {
+      CONFIG_DEBUG.traceFormat = TRACE_TEXT;
+    } else if (!strcmp(val, "BINARY")) {
+      CONFIG_DEBUG.traceFormat = TRACE_BINARY;
+    } else {
+      config_throwInvalidConfigVal(arg, val);
+    }
+  } else if (!strcmp(arg, "DEBUG_shouldRecordFlight")) {
+    CONFIG_DEBUG.shouldRecordFlight = config_boolFromString(arg, val);
+  } else if (!strcmp(arg, "DEBUG_shouldProfile")) {
+    CONFIG_DEBUG.shouldProfile = config_boolFromString(arg, val);
+  } else if (!strcmp(arg, "DEBUG_shouldCountHostEvents")) {
+    CONFIG_DEBUG.shouldCountHostEvents = config_boolFromString(arg, val);
+  } else if (!strcmp(arg, "DEBUG_shouldLogCodeData")) {
+    CONFIG_DEBUG.shouldLogCodeData = config_boolFromString(arg, val);
   } else if (!strcmp(arg, "DEBUG_shouldLimitFrequency")) {
     CONFIG_DEBUG.shouldLimitFrequency = config_boolFromString(arg, val);
   } else if (!strcmp(arg, "DEBUG_shouldDebugCPU")) {
     CONFIG_DEBUG.shouldDebugCPU = config_boolFromString(arg, val);
+  } else if (!strcmp(arg, "HEADLESS_videoPath")) {
+    config_pathFromString(CONFIG_HEADLESS.videoPath, val);
+  } else if (!strcmp(arg, "HEADLESS_videoFormat")) {
+    if (!strcmp(val, "Y4M")) {
+      CONFIG_HEADLESS.videoFormat = VIDEO_Y4M;
+    } else if (!strcmp(val, "RGB")) {
+      CONFIG_HEADLESS.videoFormat = VIDEO_RGB;
+    } else {
+      config_throwInvalidConfigVal(arg, val);
+    }
+  } else if (!strcmp(arg, "HEADLESS_inputPath")) {
+    config_pathFromString(CONFIG_HEADLESS.inputPath, val);
+  } else if (!strcmp(arg, "HEADLESS_frameLimit")) {
+    CONFIG_HEADLESS.frameLimit = atoi(val);
+  } else if (!strcmp(arg, "CAPTURE_path")) {
+    config_pathFromString(CONFIG_CAPTURE.path, val);
+  } else if (!strcmp(arg, "CAPTURE_format")) {
+    if (!strcmp(val, "Y4M")) {
+      CONFIG_CAPTURE.format = VIDEO_Y4M;
+    } else if (!strcmp(val, "PPM")) {
+      CONFIG_CAPTURE.format = VIDEO_PPM;
+    } else {
+      config_throwInvalidConfigVal(arg, val);
+    }
+  } else if (!strcmp(arg, "SHM_name")) {
+    config_pathFromString(CONFIG_SHM.name, val);
+  } else if (!strcmp(arg, "REWIND_bufferSize")) {
+    CONFIG_REWIND.bufferSize = atoi(val);
+  } else if (!strcmp(arg, "RUNAHEAD_frames")) {
+    CONFIG_RUNAHEAD.frames = atoi(val);
+  } else if (!strcmp(arg, "FASTFORWARD_multiplier")) {
+    CONFIG_FASTFORWARD.multiplier = atoi(val);
+  } else if (!strcmp(arg, "BOOT_cacheFrames")) {
+    CONFIG_BOOT.cacheFrames = atoi(val);
+  } else if (!strcmp(arg, "MOVIE_record")) {
+    config_pathFromString(CONFIG_MOVIE.recordPath, val);
+  } else if (!strcmp(arg, "MOVIE_replay")) {
+    config_pathFromString(CONFIG_MOVIE.replayPath, val);
+  } else if (!strcmp(arg, "HASH_log")) {
+    config_pathFromString(CONFIG_HASH.logPath, val);
+  } else if (!strcmp(arg, "HASH_compare")) {
+    config_pathFromString(CONFIG_HASH.comparePath, val);
+  } else if (!strcmp(arg, "GOLDEN_list")) {
+    config_pathFromString(CONFIG_GOLDEN.listPath, val);
+  } else if (!strcmp(arg, "GOLDEN_shouldUpdate")) {
+    CONFIG_GOLDEN.shouldUpdate = config_boolFromString(arg, val);
+  } else if (!strcmp(arg, "TIMELINE_path")) {
+    config_pathFromString(CONFIG_TIMELINE.path, val);
   } else {
     config_throwInvalidConfigArg(arg);
   }
@@ -159,4 +346,10 @@ bool config_boolFromString(char* arg, char* val) {
   }
 }
 
+void config_pathFromString(char* dest, char* val) {
+  // config buffer is freed after parsing, so keep a copy of the value
+  strncpy(dest, val, FILEIO_MAX_PATH_SIZE - 1);
+  dest[FILEIO_MAX_PATH_SIZE - 1] = '\0';
+}
+
 #endif
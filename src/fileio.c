@@ -25,6 +25,10 @@ int fileio_writeStringToFile(char* path, char* value, uint8_t append) {
   return -1;
 }
 
+int fileio_writeBinaryToFile(char* path, void* data, size_t size) {
+  return -1;
+}
+
 #else
 
 int fileio_writeStringToFile(char* path, char* value, uint8_t append) {
@@ -40,6 +44,19 @@ int fileio_writeStringToFile(char* path, char* value, uint8_t append) {
   return 0;
 }
 
+int fileio_writeBinaryToFile(char* path, void* data, size_t size) {
+  FILE* fp;
+  fp = fopen(path, "wb");
+
+  if (fp == NULL) return -1;
+
+  size_t n = fwrite(data, 1, size, fp);
+
+  fclose(fp);
+
+  return (n == size) ? 0 : -1;
+}
+
 int fileio_readFileAsString(char* path, char** output) {
   int binarySize = 0;
   FILE* fp;
@@ -59,12 +76,13 @@ int fileio_readFileAsString(char* path, char** output) {
   // populate binary object with file data
   uint32_t count = 0;
   while ((n = fread(buffer, 1, 16, fp)) > 0) {
-    for (int i = 0; i < 16; i++) {
+    for (int i = 0; i < n; i++) {
       (*output)[count] = buffer[i];
       count += 1;
     }
   }
   (*output)[binarySize - 1] = '\0';
+  fclose(fp);
   return binarySize;
 }
 
@@ -87,11 +105,12 @@ int fileio_readFileAsBinary(char* path, uint8_t** output) {
   // populate binary object with file data
   uint32_t count = 0;
   while ((n = fread(buffer, 1, 16, fp)) > 0) {
-    for (int i = 0; i < 16; i++) {
+    for (int i = 0; i < n; i++) {
       (*output)[count] = buffer[i];
       count += 1;
     }
   }
+  fclose(fp);
   return binarySize;
 }
 
@@ -0,0 +1,61 @@
+/**
+ * flight.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/flight.h"
+
+TraceRecord* flightRing = NULL;
+uint32_t flightIndex = 0;
+bool flightWrapped = false;
+
+bool flight_init(void) {
+  flightRing = calloc(FLIGHT_CAPACITY, sizeof(TraceRecord));
+  return flightRing != NULL;
+}
+
+TraceRecord* flight_next(void) {
+  TraceRecord* record = flightRing + flightIndex;
+  flightIndex = (flightIndex + 1) & (FLIGHT_CAPACITY - 1);
+  flightWrapped |= (flightIndex == 0);
+  return record;
+}
+
+#if (SUPPRESS_EXTIO)
+
+int flight_dump(char* path) {
+  return -1;
+}
+
+#else
+
+int flight_dump(char* path) {
+  if (flightRing == NULL) return -1;
+
+  FILE* fp = fopen(path, "wb");
+  if (fp == NULL) return -1;
+
+  TraceLogHeader header;
+  header.magic = TRACELOG_MAGIC;
+  header.version = TRACELOG_VERSION;
+  header.recordSize = sizeof(TraceRecord);
+  header.reserved = 0;
+  fwrite(&header, sizeof(TraceLogHeader), 1, fp);
+
+  // the slot about to be overwritten holds the oldest record
+  if (flightWrapped) {
+    fwrite(flightRing + flightIndex, sizeof(TraceRecord), FLIGHT_CAPACITY - flightIndex, fp);
+  }
+  fwrite(flightRing, sizeof(TraceRecord), flightIndex, fp);
+  fclose(fp);
+
+  return flightWrapped ? FLIGHT_CAPACITY : flightIndex;
+}
+
+#endif
+
+bool flight_isActive(void) {
+  return flightRing != NULL;
+}
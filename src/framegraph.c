@@ -0,0 +1,87 @@
+/**
+ * framegraph.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/framegraph.h"
+
+uint32_t frameTimes[FRAMEGRAPH_FRAMES][FRAMEGRAPH_PHASES];
+uint32_t frameIndex = 0;
+uint32_t frameTime[FRAMEGRAPH_PHASES];
+uint32_t missedDeadlines = 0;
+
+#if (SUPPRESS_TIMING)
+
+void framegraph_mark(FrameGraphPhase phase) {}
+void framegraph_endFrame(void) {}
+
+#else
+
+struct timeval lastMark;
+bool hasMark = false;
+
+void framegraph_mark(FrameGraphPhase phase) {
+  struct timeval now;
+  gettimeofday(&now, 0);
+  if (hasMark) {
+    frameTime[phase] += ((now.tv_sec - lastMark.tv_sec) * 1000000) + now.tv_usec - lastMark.tv_usec;
+  }
+  lastMark = now;
+  hasMark = true;
+}
+
+void framegraph_endFrame(void) {
+  // sleep only pads out the interval, so it can't make a frame late
+  if (frameTime[FRAMEGRAPH_EMULATION] + frameTime[FRAMEGRAPH_RENDER] > TIMING_INTERVAL) {
+    missedDeadlines++;
+  }
+  memcpy(frameTimes[frameIndex], frameTime, sizeof(frameTime));
+  memset(frameTime, 0, sizeof(frameTime));
+  frameIndex = (frameIndex + 1) % FRAMEGRAPH_FRAMES;
+}
+
+#endif
+
+void framegraph_draw(void) {
+  static const uint32_t colors[FRAMEGRAPH_PHASES] = { 0x4060FF, 0x40C040, 0x606060 };
+  int width = CONFIG_DISPLAY.width;
+  int bottom = FRAMEGRAPH_TOP + FRAMEGRAPH_HEIGHT - 1;
+  if (bottom >= CONFIG_DISPLAY.height) return;
+
+  char label[64];
+  memset(label, '\n', FRAMEGRAPH_LABEL_ROW);
+  sprintf(label + FRAMEGRAPH_LABEL_ROW, "Frame Time  %u missed", missedDeadlines);
+  io_drawString(label, 2);
+
+  for (int col = 0; col < FRAMEGRAPH_FRAMES && col < width; col++) {
+    // oldest frame on the left
+    uint32_t* times = frameTimes[(frameIndex + col) % FRAMEGRAPH_FRAMES];
+    uint32_t total = 0;
+    int y = bottom;
+    for (int phase = 0; phase < FRAMEGRAPH_PHASES; phase++) {
+      // stack on the running total so rounding doesn't add up across phases
+      total += times[phase];
+      int top = bottom - (int) (total / FRAMEGRAPH_US_PER_PIXEL);
+      for (; y > top && y >= FRAMEGRAPH_TOP; y--) {
+        BITMAP2[(y * width) + col] = colors[phase];
+      }
+    }
+    for (; y >= FRAMEGRAPH_TOP; y--) {
+      BITMAP2[(y * width) + col] = 0x000000;
+    }
+  }
+
+  // dotted reference lines at 60 Hz and 30 Hz
+  int line60 = bottom - (1000000 / 60) / FRAMEGRAPH_US_PER_PIXEL;
+  int line30 = bottom - (1000000 / 30) / FRAMEGRAPH_US_PER_PIXEL;
+  for (int col = 0; col < FRAMEGRAPH_FRAMES && col < width; col += 2) {
+    BITMAP2[(line60 * width) + col] = 0xFFFF00;
+    BITMAP2[(line30 * width) + col] = 0xFF4040;
+  }
+}
+
+uint32_t framegraph_missedDeadlines(void) {
+  return missedDeadlines;
+}
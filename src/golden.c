@@ -0,0 +1,265 @@
+/**
+ * golden.c
+ * 
+ * Each ROM runs in a forked child, so a crash or panic only fails that
+ * entry and no emulator state has to be reset between ROMs. Children send
+ * their final frame hash back through a pipe.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/golden.h"
+#include "include/nes.h"
+
+#if (SUPPRESS_EXTIO || SUPPRESS_TIMING || IO_LIBRARY != HEADLESS)
+
+int golden_run(char* listPath, bool shouldUpdate) {
+  io_panic("Golden runs require a headless build.");
+  return EXIT_FAILURE;
+}
+
+void golden_reportFrame(uint32_t* bmp, uint32_t frames) {}
+
+#else
+
+#include <sys/wait.h>
+
+GoldenEntry goldenEntries[GOLDEN_MAX_ENTRIES];
+int goldenEntryCount = 0;
+int goldenReportFd = -1;
+
+bool golden_parseList(char* listPath) {
+  char* listStr;
+  if (fileio_readFileAsString(listPath, &listStr) == -1) {
+    return false;
+  }
+
+  // lines are counted the same way golden_writeList() counts them
+  int lineNumber = 0;
+  char* line = listStr;
+  while (*line != '\0') {
+    char* lineEnd = strchr(line, '\n');
+    if (lineEnd != NULL) *lineEnd = '\0';
+    lineNumber += 1;
+
+    GoldenEntry entry;
+    char hashStr[32];
+    memset(&entry, 0, sizeof(entry));
+
+    // a frame count of 0 would never stop and anything but a ROM would open the selector
+    bool isEntry = line[0] != '#' && sscanf(line, "%1023s %u %1023s %31s", entry.romPath, &entry.frames, entry.moviePath, hashStr) == 4;
+    if (isEntry && entry.frames > 0 && nescartridge_isRomFile(entry.romPath)) {
+      if (goldenEntryCount == GOLDEN_MAX_ENTRIES) {
+        fprintf(stderr, "GOLDEN: more than %d entries in '%s'\n", GOLDEN_MAX_ENTRIES, listPath);
+        break;
+      }
+      if (!strcmp(entry.moviePath, "-")) {
+        entry.moviePath[0] = '\0';
+      }
+      entry.hasExpectedHash = strcmp(hashStr, "-") != 0;
+      entry.expectedHash = entry.hasExpectedHash ? strtoull(hashStr, NULL, 16) : 0;
+      entry.line = lineNumber;
+      entry.fd = -1;
+      goldenEntries[goldenEntryCount] = entry;
+      goldenEntryCount += 1;
+    } else if (line[0] != '#' && line[0] != '\0') {
+      fprintf(stderr, "GOLDEN: ignoring line %d of '%s'\n", lineNumber, listPath);
+    }
+
+    if (lineEnd == NULL) break;
+    line = lineEnd + 1;
+  }
+
+  free(listStr);
+  return true;
+}
+
+void golden_runChild(GoldenEntry* entry, int fd) {
+  goldenReportFd = fd;
+
+  CONFIG_HEADLESS.frameLimit = entry->frames;
+  strcpy(CONFIG_MOVIE.replayPath, entry->moviePath);
+  CONFIG_MOVIE.recordPath[0] = '\0';
+
+  // children run side by side, so nothing may wait on real time or write to
+  // a path the others would write to as well
+  CONFIG_DEBUG.shouldLimitFrequency = false;
+  CONFIG_DEBUG.shouldTraceInstructions = false;
+  CONFIG_DEBUG.shouldRecordFlight = false;
+  CONFIG_DEBUG.shouldProfile = false;
+  CONFIG_DEBUG.shouldLogCodeData = false;
+  CONFIG_SHM.name[0] = '\0';
+  CONFIG_HASH.logPath[0] = '\0';
+  CONFIG_HASH.comparePath[0] = '\0';
+  CONFIG_TIMELINE.path[0] = '\0';
+  // the reported hash has to cover the real frame, without spending time on rewind
+  CONFIG_RUNAHEAD.frames = 0;
+  CONFIG_REWIND.bufferSize = 0;
+
+  // the parent started the clock before any child was forked
+  io_restartClock();
+
+  // exits through golden_reportFrame once the last frame is finished
+  nes_init(entry->romPath);
+  exit(EXIT_FAILURE);
+}
+
+void golden_reportFrame(uint32_t* bmp, uint32_t frames) {
+  if (goldenReportFd == -1) return;
+
+  GoldenResult result;
+  result.hash = hash_compute((uint8_t*) bmp, sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height, 0);
+  result.frames = frames;
+  if (write(goldenReportFd, &result, sizeof(result)) != sizeof(result)) {
+    // the parent reports the entry as unfinished, since it can't read a result
+    fprintf(stderr, "GOLDEN: unable to report result for frame %u\n", frames);
+  }
+  close(goldenReportFd);
+  goldenReportFd = -1;
+}
+
+bool golden_start(GoldenEntry* entry) {
+  int fds[2];
+  if (pipe(fds) == -1) return false;
+
+  // anything still buffered would be written again by the child
+  fflush(stdout);
+  fflush(stderr);
+
+  int pid = fork();
+  if (pid == -1) {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  } else if (pid == 0) {
+    close(fds[0]);
+    golden_runChild(entry, fds[1]);
+  }
+
+  close(fds[1]);
+  entry->pid = pid;
+  entry->fd = fds[0];
+  return true;
+}
+
+void golden_collect(GoldenEntry* entry, int status) {
+  GoldenResult result;
+  bool didRead = read(entry->fd, &result, sizeof(result)) == sizeof(result);
+  close(entry->fd);
+  entry->fd = -1;
+
+  entry->didFinish = didRead && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+  entry->hash = didRead ? result.hash : 0;
+}
+
+bool golden_writeList(char* listPath) {
+  // keep comments and unparsed lines where they were
+  char* listStr;
+  if (fileio_readFileAsString(listPath, &listStr) == -1) {
+    return false;
+  }
+
+  FILE* fp = fopen(listPath, "w");
+  if (fp == NULL) {
+    free(listStr);
+    return false;
+  }
+
+  int lineNumber = 0;
+  int entryIndex = 0;
+  char* lineStart = listStr;
+  while (*lineStart != '\0') {
+    char* lineEnd = strchr(lineStart, '\n');
+    size_t lineLength = (lineEnd != NULL) ? (size_t) (lineEnd - lineStart) : strlen(lineStart);
+    lineNumber += 1;
+
+    GoldenEntry* entry = (entryIndex < goldenEntryCount) ? &goldenEntries[entryIndex] : NULL;
+    if (entry != NULL && entry->line == lineNumber) {
+      if (entry->didFinish) {
+        fprintf(fp, "%s %u %s %016llX\n", entry->romPath, entry->frames,
+          entry->moviePath[0] != '\0' ? entry->moviePath : "-", (unsigned long long) entry->hash);
+      } else {
+        fprintf(fp, "%.*s\n", (int) lineLength, lineStart);
+      }
+      entryIndex += 1;
+    } else {
+      fprintf(fp, "%.*s\n", (int) lineLength, lineStart);
+    }
+
+    if (lineEnd == NULL) break;
+    lineStart = lineEnd + 1;
+  }
+
+  fclose(fp);
+  free(listStr);
+  return true;
+}
+
+int golden_run(char* listPath, bool shouldUpdate) {
+  if (!golden_parseList(listPath)) {
+    fprintf(stderr, "GOLDEN: unable to read '%s'\n", listPath);
+    return EXIT_FAILURE;
+  }
+
+  long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+  if (jobs < 1) jobs = 1;
+
+  int started = 0;
+  int running = 0;
+  int finished = 0;
+  while (finished < goldenEntryCount) {
+    while (running < jobs && started < goldenEntryCount) {
+      if (!golden_start(&goldenEntries[started])) {
+        fprintf(stderr, "GOLDEN: unable to start '%s'\n", goldenEntries[started].romPath);
+        finished += 1;
+      } else {
+        running += 1;
+      }
+      started += 1;
+    }
+
+    if (running == 0) continue;
+
+    int status;
+    int pid = waitpid(-1, &status, 0);
+    if (pid == -1) break;
+
+    for (int i = 0; i < goldenEntryCount; i++) {
+      if (goldenEntries[i].pid == pid && goldenEntries[i].fd != -1) {
+        golden_collect(&goldenEntries[i], status);
+        running -= 1;
+        finished += 1;
+        break;
+      }
+    }
+  }
+
+  int passed = 0;
+  int failed = 0;
+  for (int i = 0; i < goldenEntryCount; i++) {
+    GoldenEntry* entry = &goldenEntries[i];
+    if (!entry->didFinish) {
+      printf("GOLDEN: ERROR %s (did not reach frame %u)\n", entry->romPath, entry->frames);
+      failed += 1;
+    } else if (shouldUpdate || (entry->hasExpectedHash && entry->hash == entry->expectedHash)) {
+      printf("GOLDEN: %s %s %016llX\n", shouldUpdate ? "UPDATE" : "PASS", entry->romPath, (unsigned long long) entry->hash);
+      passed += 1;
+    } else {
+      printf("GOLDEN: FAIL %s (expected %016llX, got %016llX)\n", entry->romPath,
+        (unsigned long long) entry->expectedHash, (unsigned long long) entry->hash);
+      failed += 1;
+    }
+  }
+
+  printf("GOLDEN: %d passed, %d failed\n", passed, failed);
+
+  if (shouldUpdate && !golden_writeList(listPath)) {
+    fprintf(stderr, "GOLDEN: unable to update '%s'\n", listPath);
+    return EXIT_FAILURE;
+  }
+
+  return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif
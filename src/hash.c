@@ -0,0 +1,323 @@
+/**
+ * hash.c
+ * 
+ * Input is consumed in 64-byte stripes by 8 independent 64-bit lanes, which
+ * maps directly onto SIMD registers. The layout follows XXH3's long-input
+ * loop, but the secret and the tail handling are simplified, so the values
+ * are not compatible with XXH3 itself.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/hash.h"
+
+#if (HOST_SSE2)
+#include <emmintrin.h>
+#endif
+
+#define HASH_PRIME32_1 0x9E3779B1U
+#define HASH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIME64_3 0x165667B19E3779F9ULL
+
+uint8_t hashSecret[HASH_SECRET_SIZE];
+bool hashHasSecret = false;
+
+static inline uint64_t hash_read64(const uint8_t* p) {
+  uint64_t val;
+  memcpy(&val, p, sizeof(val));
+  return val;
+}
+
+static uint64_t hash_mix128(uint64_t a, uint64_t b) {
+  // fold the 128-bit product of a and b into 64 bits
+  uint64_t aLo = a & 0xFFFFFFFF, aHi = a >> 32;
+  uint64_t bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+  uint64_t lolo = aLo * bLo;
+  uint64_t hilo = aHi * bLo;
+  uint64_t lohi = aLo * bHi;
+  uint64_t hihi = aHi * bHi;
+  uint64_t cross = (lolo >> 32) + (hilo & 0xFFFFFFFF) + lohi;
+  uint64_t upper = (hilo >> 32) + (cross >> 32) + hihi;
+  uint64_t lower = (cross << 32) | (lolo & 0xFFFFFFFF);
+  return lower ^ upper;
+}
+
+static uint64_t hash_avalanche(uint64_t h) {
+  h ^= h >> 37;
+  h *= 0x165667919E3779F9ULL;
+  h ^= h >> 32;
+  return h;
+}
+
+static void hash_generateSecret(void) {
+  // any fixed, well mixed bytes will do
+  uint64_t state = HASH_PRIME64_3;
+  for (int i = 0; i < HASH_SECRET_SIZE; i += 8) {
+    state += HASH_PRIME64_1;
+    uint64_t val = hash_avalanche(state ^ (state >> 29));
+    memcpy(hashSecret + i, &val, sizeof(val));
+  }
+  hashHasSecret = true;
+}
+
+static inline void hash_accumulateScalar(uint64_t acc[8], const uint8_t* stripe, const uint8_t* secret) {
+  for (int i = 0; i < 8; i++) {
+    uint64_t data = hash_read64(stripe + (i * 8));
+    uint64_t key = data ^ hash_read64(secret + (i * 8));
+    acc[i ^ 1] += data;
+    acc[i] += (key & 0xFFFFFFFF) * (key >> 32);
+  }
+}
+
+static inline void hash_scrambleScalar(uint64_t acc[8], const uint8_t* secret) {
+  for (int i = 0; i < 8; i++) {
+    uint64_t val = acc[i];
+    val ^= val >> 47;
+    val ^= hash_read64(secret + (i * 8));
+    acc[i] = val * HASH_PRIME32_1;
+  }
+}
+
+#if (HOST_SSE2)
+
+static inline void hash_accumulateSSE2(__m128i acc[4], const uint8_t* stripe, const uint8_t* secret) {
+  for (int i = 0; i < 4; i++) {
+    __m128i data = _mm_loadu_si128((const __m128i*) (stripe + (i * 16)));
+    __m128i key = _mm_xor_si128(data, _mm_loadu_si128((const __m128i*) (secret + (i * 16))));
+    __m128i keyHi = _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1));
+    __m128i product = _mm_mul_epu32(key, keyHi);
+    __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+    acc[i] = _mm_add_epi64(acc[i], _mm_add_epi64(product, swapped));
+  }
+}
+
+static inline void hash_scrambleSSE2(__m128i acc[4], const uint8_t* secret) {
+  const __m128i prime = _mm_set1_epi32(HASH_PRIME32_1);
+  for (int i = 0; i < 4; i++) {
+    __m128i val = _mm_xor_si128(acc[i], _mm_srli_epi64(acc[i], 47));
+    val = _mm_xor_si128(val, _mm_loadu_si128((const __m128i*) (secret + (i * 16))));
+
+    // 64x32 multiply built from two 32x32 multiplies
+    __m128i valHi = _mm_shuffle_epi32(val, _MM_SHUFFLE(0, 3, 0, 1));
+    __m128i productLo = _mm_mul_epu32(val, prime);
+    __m128i productHi = _mm_mul_epu32(valHi, prime);
+    acc[i] = _mm_add_epi64(productLo, _mm_slli_epi64(productHi, 32));
+  }
+}
+
+#endif
+
+uint64_t hash_compute(const uint8_t* data, size_t size, uint64_t seed) {
+  if (!hashHasSecret) {
+    hash_generateSecret();
+  }
+
+  uint64_t acc[8] = {
+    HASH_PRIME32_1 + seed, HASH_PRIME64_1, HASH_PRIME64_2, HASH_PRIME64_3,
+    HASH_PRIME64_1 ^ seed, HASH_PRIME64_2, HASH_PRIME32_1, HASH_PRIME64_3 - seed
+  };
+
+  size_t stripes = size / HASH_STRIPE_SIZE;
+  int secretLimit = (HASH_SECRET_SIZE - HASH_STRIPE_SIZE) / 8;
+
+#if (HOST_SSE2)
+  __m128i vacc[4];
+  memcpy(vacc, acc, sizeof(acc));
+  for (size_t s = 0; s < stripes; s++) {
+    size_t lane = s % HASH_STRIPES_PER_BLOCK;
+    hash_accumulateSSE2(vacc, data + (s * HASH_STRIPE_SIZE), hashSecret + ((lane % secretLimit) * 8));
+    if (lane == HASH_STRIPES_PER_BLOCK - 1) {
+      hash_scrambleSSE2(vacc, hashSecret + HASH_SECRET_SIZE - HASH_STRIPE_SIZE);
+    }
+  }
+  memcpy(acc, vacc, sizeof(acc));
+#else
+  for (size_t s = 0; s < stripes; s++) {
+    size_t lane = s % HASH_STRIPES_PER_BLOCK;
+    hash_accumulateScalar(acc, data + (s * HASH_STRIPE_SIZE), hashSecret + ((lane % secretLimit) * 8));
+    if (lane == HASH_STRIPES_PER_BLOCK - 1) {
+      hash_scrambleScalar(acc, hashSecret + HASH_SECRET_SIZE - HASH_STRIPE_SIZE);
+    }
+  }
+#endif
+
+  // the tail is zero padded into one last stripe; the length is mixed in below
+  size_t tail = size - (stripes * HASH_STRIPE_SIZE);
+  if (tail > 0) {
+    uint8_t last[HASH_STRIPE_SIZE];
+    memset(last, 0, sizeof(last));
+    memcpy(last, data + (stripes * HASH_STRIPE_SIZE), tail);
+    hash_accumulateScalar(acc, last, hashSecret + 7);
+  }
+
+  uint64_t result = (uint64_t) size * HASH_PRIME64_1;
+  for (int i = 0; i < 4; i++) {
+    result += hash_mix128(acc[i * 2] ^ hash_read64(hashSecret + 11 + (i * 16)),
+                          acc[(i * 2) + 1] ^ hash_read64(hashSecret + 19 + (i * 16)));
+  }
+  return hash_avalanche(result);
+}
+
+#if (SUPPRESS_EXTIO)
+
+bool hash_startLog(char* path, uint64_t romHash) {
+  return false;
+}
+
+bool hash_loadReference(char* path) {
+  return false;
+}
+
+uint64_t hash_referenceRomHash(void) {
+  return 0;
+}
+
+bool hash_recordFrame(uint32_t frame, uint64_t hash) {
+  return true;
+}
+
+bool hash_checkFrame(uint32_t frame, uint64_t hash) {
+  return true;
+}
+
+uint64_t hash_expectedFrame(uint32_t frame) {
+  return 0;
+}
+
+bool hash_isActive(void) {
+  return false;
+}
+
+void hash_finish(void) {}
+
+#else
+
+HashLogHeader hashLogHeader;
+uint64_t* hashLog = NULL;
+uint32_t hashLogCapacity = 0;
+char hashLogPath[FILEIO_MAX_PATH_SIZE];
+bool hashLogging = false;
+
+HashLogHeader hashReferenceHeader;
+uint64_t* hashReference = NULL;
+uint32_t hashMatchedFrames = 0;
+
+bool hash_startLog(char* path, uint64_t romHash) {
+  strncpy(hashLogPath, path, FILEIO_MAX_PATH_SIZE - 1);
+  hashLogPath[FILEIO_MAX_PATH_SIZE - 1] = '\0';
+
+  // make sure the log can be written before anything is hashed
+  FILE* fp = fopen(hashLogPath, "wb");
+  if (fp == NULL) return false;
+  fclose(fp);
+
+  hashLogHeader.magic = HASH_LOG_MAGIC;
+  hashLogHeader.version = HASH_LOG_VERSION;
+  hashLogHeader.romHash = romHash;
+  hashLogHeader.frames = 0;
+  hashLogHeader.reserved = 0;
+
+  hashLogCapacity = 60 * 60;
+  hashLog = malloc(sizeof(uint64_t) * hashLogCapacity);
+  if (hashLog == NULL) return false;
+
+  hashLogging = true;
+  atexit(&hash_finish);
+  return true;
+}
+
+bool hash_loadReference(char* path) {
+  uint8_t* data;
+  int size = fileio_readFileAsBinary(path, &data);
+  if (size == -1) return false;
+
+  if (size < sizeof(HashLogHeader)) {
+    free(data);
+    return false;
+  }
+
+  memcpy(&hashReferenceHeader, data, sizeof(HashLogHeader));
+  if (hashReferenceHeader.magic != HASH_LOG_MAGIC || hashReferenceHeader.version != HASH_LOG_VERSION
+      || (size - sizeof(HashLogHeader)) / sizeof(uint64_t) < hashReferenceHeader.frames) {
+    free(data);
+    return false;
+  }
+
+  hashReference = malloc(sizeof(uint64_t) * (hashReferenceHeader.frames + 1));
+  memcpy(hashReference, data + sizeof(HashLogHeader), sizeof(uint64_t) * hashReferenceHeader.frames);
+  free(data);
+
+  if (!hashLogging) {
+    atexit(&hash_finish);
+  }
+  return true;
+}
+
+uint64_t hash_referenceRomHash(void) {
+  return hashReferenceHeader.romHash;
+}
+
+bool hash_recordFrame(uint32_t frame, uint64_t hash) {
+  if (!hashLogging) return true;
+
+  if (frame >= hashLogCapacity) {
+    uint32_t capacity = hashLogCapacity;
+    while (frame >= capacity) {
+      capacity *= 2;
+    }
+    uint64_t* log = realloc(hashLog, sizeof(uint64_t) * capacity);
+    if (log == NULL) return false;
+    hashLog = log;
+    hashLogCapacity = capacity;
+  }
+
+  if (frame > hashLogHeader.frames) {
+    memset(hashLog + hashLogHeader.frames, 0, sizeof(uint64_t) * (frame - hashLogHeader.frames));
+  }
+
+  hashLog[frame] = hash;
+  hashLogHeader.frames = frame + 1;
+  return true;
+}
+
+bool hash_checkFrame(uint32_t frame, uint64_t hash) {
+  if (hashReference == NULL || frame >= hashReferenceHeader.frames) return true;
+
+  if (hashReference[frame] != hash) {
+    return false;
+  }
+  hashMatchedFrames += 1;
+  return true;
+}
+
+uint64_t hash_expectedFrame(uint32_t frame) {
+  if (hashReference == NULL || frame >= hashReferenceHeader.frames) return 0;
+  return hashReference[frame];
+}
+
+bool hash_isActive(void) {
+  return hashLogging || hashReference != NULL;
+}
+
+void hash_finish(void) {
+  if (hashLogging) {
+    hashLogging = false;
+    FILE* fp = fopen(hashLogPath, "wb");
+    if (fp != NULL) {
+      fwrite(&hashLogHeader, sizeof(HashLogHeader), 1, fp);
+      fwrite(hashLog, sizeof(uint64_t), hashLogHeader.frames, fp);
+      fclose(fp);
+    }
+    fprintf(stderr, "HASH: %u frames logged\n", hashLogHeader.frames);
+  }
+
+  if (hashReference != NULL) {
+    fprintf(stderr, "HASH: %u of %u reference frames matched\n", hashMatchedFrames, hashReferenceHeader.frames);
+    free(hashReference);
+    hashReference = NULL;
+  }
+}
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * heatmap.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/heatmap.h"
+
+bool isHeatmapActive = false;
+uint32_t* heatCounts = NULL;
+uint8_t* heatLevels = NULL;
+
+bool heatmap_setActive(bool isActive) {
+  if (isActive && heatCounts == NULL) {
+    heatCounts = calloc(HEATMAP_KINDS * 65536, sizeof(uint32_t));
+    heatLevels = calloc(HEATMAP_KINDS * 65536, sizeof(uint8_t));
+    if (heatCounts == NULL || heatLevels == NULL) return false;
+  }
+  isHeatmapActive = isActive;
+  return true;
+}
+
+void heatmap_count(HeatmapKind kind, uint16_t addr) {
+  if (addr >= 0x2000 && addr <= 0x3FFF) {
+    addr = 0x2000 + (addr % 0x08);
+  }
+  heatCounts[(kind * 65536) + addr]++;
+}
+
+void heatmap_draw(uint32_t* bmp) {
+  for (int row = 0; row < CONFIG_DISPLAY.height && row < 256 - HEATMAP_SKIPPED_PAGES; row++) {
+    int page = (row < HEATMAP_SKIPPED_PAGE) ? row : row + HEATMAP_SKIPPED_PAGES;
+    for (int col = 0; col < HEATMAP_WIDTH; col++) {
+      int addr = (page << 8) | col;
+      uint32_t color = 0;
+
+      for (int kind = 0; kind < HEATMAP_KINDS; kind++) {
+        // brightness grows with the log of this frame's accesses, then fades
+        int index = (kind * 65536) + addr;
+        uint32_t count = heatCounts[index];
+        uint32_t level = (heatLevels[index] * HEATMAP_DECAY) >> 8;
+        if (count > 0) {
+          uint32_t frameLevel = HEATMAP_BASE_LEVEL + (HEATMAP_LEVEL_STEP * (32 - __builtin_clz(count)));
+          frameLevel = (frameLevel > 0xFF) ? 0xFF : frameLevel;
+          level = (frameLevel > level) ? frameLevel : level;
+        }
+        heatLevels[index] = level;
+        heatCounts[index] = 0;
+
+        int shift = (kind == HEATMAP_WRITE) ? 16 : ((kind == HEATMAP_READ) ? 8 : 0);
+        color |= (uint32_t) heatLevels[index] << shift;
+      }
+
+      bmp[(row * CONFIG_DISPLAY.width) + col] = color;
+    }
+  }
+}
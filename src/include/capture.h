@@ -0,0 +1,49 @@
+/**
+ * capture.h
+ * 
+ * Record finished frames to disk from a background thread.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include "global.h"
+#include "config.h"
+#include "video.h"
+
+// number of frames which may be waiting to be written before frames are dropped
+#define CAPTURE_RING_SIZE 64
+
+// how long the writer thread sleeps when there is nothing to write
+#define CAPTURE_IDLE_US 2000
+
+bool capture_init(char* path, VideoFormat format, int width, int height);
+void capture_submitFrame(uint32_t* bmp);
+void capture_finish(void);
+bool capture_isActive(void);
+uint32_t capture_droppedFrames(void);
+
+#endif
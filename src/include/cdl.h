@@ -0,0 +1,83 @@
+/**
+ * cdl.h
+ * 
+ * Code/data log of which PRG bytes were executed or read, keyed by ROM hash.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CDL_H
+#define CDL_H
+
+#include "global.h"
+#include "config.h"
+#include "fileio.h"
+
+// FCEUX-compatible flags, so logs can be shared with its tools
+#define CDL_CODE 0x01
+#define CDL_DATA 0x02
+
+// unused by FCEUX: the byte was fetched as an opcode, not as an operand
+#define CDL_OPCODE 0x80
+
+#define CDL_PATH "./debug/%016llX.cdl"
+
+extern bool isCodeDataLogging;
+
+/**
+ * @brief Load the log for this ROM, if one exists.
+ * @return false if the log can't be allocated
+ */
+bool cdl_load(uint64_t romHash, uint32_t prgSize, uint32_t chrSize);
+
+/**
+ * @brief Start adding to the loaded log, or to a blank one. The log is saved
+ *        on exit.
+ * @return false if the log can't be allocated
+ */
+bool cdl_startLogging(void);
+
+/**
+ * @brief Mark an instruction as code. Only call while isCodeDataLogging is set.
+ */
+void cdl_markCode(uint16_t addr, uint8_t length);
+
+/**
+ * @brief Mark a PRG byte as data. Only call while isCodeDataLogging is set.
+ */
+void cdl_markData(uint16_t addr);
+
+/**
+ * @brief The flags logged so far for a PRG byte, 0 if nothing was loaded.
+ */
+uint8_t cdl_flags(uint16_t addr);
+
+/**
+ * @brief Whether any flags were loaded or logged.
+ */
+bool cdl_isLoaded(void);
+
+void cdl_finish(void);
+
+#endif
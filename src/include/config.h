@@ -123,36 +123,123 @@ typedef enum {
   EMU_PLAT_NES
 } PlatformConfig;
 
+typedef enum {
+  VIDEO_Y4M = 0,
+  VIDEO_RGB = 1,
+  VIDEO_PPM = 2
+} VideoFormat;
+
+typedef enum {
+  TRACE_TEXT = 0,
+  TRACE_BINARY = 1
+} TraceFormat;
+
+typedef enum {
+  FILTER_NONE = 0,
+  FILTER_SCALE2X = 2,
+  FILTER_SCALE3X = 3
+} DisplayFilter;
+
 typedef struct {
   int width;
   int height;
   int scale;
   int screens;
+  DisplayFilter filter;
 } DisplayConfig;
 
 typedef struct {
   long frequency;
   bool shouldCacheInstructions;
+  bool shouldSkipIdleLoops;
 } CpuConfig;
 
 typedef struct {
   bool shouldDisplayPerformance;
   bool shouldDisplayDebugScreen;
   bool shouldTraceInstructions;
+  TraceFormat traceFormat;
+  bool shouldRecordFlight;
+  bool shouldProfile;
+  bool shouldCountHostEvents;
+  bool shouldLogCodeData;
   bool shouldLimitFrequency;
   bool shouldDebugCPU;
 } DebugConfig;
 
+typedef struct {
+  char videoPath[FILEIO_MAX_PATH_SIZE];
+  VideoFormat videoFormat;
+  char inputPath[FILEIO_MAX_PATH_SIZE];
+  long frameLimit;
+} HeadlessConfig;
+
+typedef struct {
+  char path[FILEIO_MAX_PATH_SIZE];
+  VideoFormat format;
+} CaptureConfig;
+
+typedef struct {
+  char name[FILEIO_MAX_PATH_SIZE];
+} ShmConfig;
+
+typedef struct {
+  long bufferSize;
+} RewindConfig;
+
+typedef struct {
+  int frames;
+} RunAheadConfig;
+
+typedef struct {
+  int multiplier;
+} FastForwardConfig;
+
+typedef struct {
+  int cacheFrames;
+} BootConfig;
+
+typedef struct {
+  char recordPath[FILEIO_MAX_PATH_SIZE];
+  char replayPath[FILEIO_MAX_PATH_SIZE];
+} MovieConfig;
+
+typedef struct {
+  char logPath[FILEIO_MAX_PATH_SIZE];
+  char comparePath[FILEIO_MAX_PATH_SIZE];
+} HashConfig;
+
+typedef struct {
+  char listPath[FILEIO_MAX_PATH_SIZE];
+  bool shouldUpdate;
+} GoldenConfig;
+
+typedef struct {
+  char path[FILEIO_MAX_PATH_SIZE];
+} TimelineConfig;
+
 extern PlatformConfig CONFIG_PLATFORM;
 extern DisplayConfig CONFIG_DISPLAY;
 extern CpuConfig CONFIG_CPU;
 extern DebugConfig CONFIG_DEBUG;
+extern HeadlessConfig CONFIG_HEADLESS;
+extern CaptureConfig CONFIG_CAPTURE;
+extern ShmConfig CONFIG_SHM;
+extern RewindConfig CONFIG_REWIND;
+extern RunAheadConfig CONFIG_RUNAHEAD;
+extern FastForwardConfig CONFIG_FASTFORWARD;
+extern BootConfig CONFIG_BOOT;
+extern MovieConfig CONFIG_MOVIE;
+extern HashConfig CONFIG_HASH;
+extern GoldenConfig CONFIG_GOLDEN;
+extern TimelineConfig CONFIG_TIMELINE;
 
 bool config_init(char* json);
 void config_print(void);
 void config_trimWhitespace(char** str);
 void config_parseSetting(char* line);
 bool config_boolFromString(char* arg, char* val);
+void config_pathFromString(char* dest, char* val);
 void config_throwInvalidConfig(void);
 void config_throwInvalidConfigArg(char* arg);
 void config_throwInvalidConfigVal(char* arg, char* val);
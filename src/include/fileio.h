@@ -37,6 +37,7 @@
 #define FILEIO_MAX_PATH_SIZE 1024
 
 int fileio_writeStringToFile(char* path, char* value, uint8_t append);
+int fileio_writeBinaryToFile(char* path, void* data, size_t size);
 int fileio_readFileAsString(char* path, char** output);
 int fileio_readFileAsBinary(char* path, uint8_t** output);
 int fileio_listFilesInPath(char* path, char* output[FILEIO_MAX_COUNT]);
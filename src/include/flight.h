@@ -0,0 +1,60 @@
+/**
+ * flight.h
+ * 
+ * Always-on ring of recently executed instructions for post-mortem debugging.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIGHT_H
+#define FLIGHT_H
+
+#include "global.h"
+#include "mos6502.h"
+#include "tracelog.h"
+
+#define FLIGHT_CAPACITY 65536
+#define FLIGHT_DUMP_PATH "./debug/flight.bin"
+
+/**
+ * @brief Allocate the ring of FLIGHT_CAPACITY records.
+ */
+bool flight_init(void);
+
+/**
+ * @brief Claim the slot for the next record, overwriting the oldest one once
+ *        the ring is full.
+ */
+TraceRecord* flight_next(void);
+
+/**
+ * @brief Write the ring, oldest record first, in the binary trace format so
+ *        it can be read with tracedecode.
+ * @return the number of records written, or -1 if the file can't be written
+ */
+int flight_dump(char* path);
+
+bool flight_isActive(void);
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * framegraph.h
+ * 
+ * Rolling graph of host time per frame on the debug screen.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FRAMEGRAPH_H
+#define FRAMEGRAPH_H
+
+#include "global.h"
+#include "config.h"
+#include "io.h"
+
+// one column per frame, below the palettes on the debug screen
+#define FRAMEGRAPH_FRAMES 256
+#define FRAMEGRAPH_LABEL_ROW 23
+#define FRAMEGRAPH_TOP 192
+#define FRAMEGRAPH_HEIGHT 48
+
+// 36 ms fits in the graph, so 30 Hz frames still have headroom
+#define FRAMEGRAPH_US_PER_PIXEL 750
+
+typedef enum {
+  FRAMEGRAPH_EMULATION = 0,
+  FRAMEGRAPH_RENDER = 1,
+  FRAMEGRAPH_SLEEP = 2,
+  FRAMEGRAPH_PHASES = 3
+} FrameGraphPhase;
+
+/**
+ * @brief Charge the time since the last mark to a phase of this frame.
+ */
+void framegraph_mark(FrameGraphPhase phase);
+
+/**
+ * @brief Add this frame to the graph. It missed its deadline if emulating and
+ *        rendering it took longer than TIMING_INTERVAL.
+ */
+void framegraph_endFrame(void);
+
+/**
+ * @brief Draw the graph in BITMAP2 with emulation in blue, rendering in green
+ *        and sleep in grey, newest frame on the right.
+ */
+void framegraph_draw(void);
+
+uint32_t framegraph_missedDeadlines(void);
+
+#endif
@@ -33,9 +33,13 @@
 #define FALSE 0
 #define TRUE  1
 
-#define SDL2 0
+#define SDL2     0
+#define HEADLESS 1
 
+// I/O backend, may be overridden at build time (e.g. -DIO_LIBRARY=HEADLESS)
+#ifndef IO_LIBRARY
 #define IO_LIBRARY SDL2
+#endif
 
 // fallback for if SUPPRESS_EXTIO is set
 #define FALLBACK_PLATFORM EMU_PLAT_NES
@@ -53,6 +57,11 @@
 // Always prefer space-efficient solutions vs time-efficient
 #define MINIMIZE_MEMORY FALSE
 
+// Time each subsystem per frame (see timer.h), may be overridden at build time
+#ifndef ENABLE_TIMERS
+#define ENABLE_TIMERS FALSE
+#endif
+
 #define PERFORMANCE_UPDATES_PER_SEC 60
 
 #include <stdint.h>
@@ -74,6 +83,13 @@
 
 #define force_inline __attribute__((always_inline)) inline
 
+// SIMD paths (scaler, hash) are compiled in only where the target has them
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define HOST_SSE2 TRUE
+#else
+#define HOST_SSE2 FALSE
+#endif
+
 #define GET_bit0(val) (val & 1)
 #define GET_bit1(val) ((val >> 1) & 1)
 #define GET_bit2(val) ((val >> 2) & 1)
@@ -0,0 +1,81 @@
+/**
+ * golden.h
+ * 
+ * Golden-frame regression harness for headless builds.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+#include "global.h"
+#include "config.h"
+#include "fileio.h"
+#include "hash.h"
+
+#define GOLDEN_MAX_ENTRIES 256
+
+/**
+ * @brief One line of a golden list: `<rom> <frames> <movie|-> <hash|->`
+ */
+typedef struct {
+  char romPath[FILEIO_MAX_PATH_SIZE];
+  char moviePath[FILEIO_MAX_PATH_SIZE];
+  uint32_t frames;
+  uint64_t expectedHash;
+  bool hasExpectedHash;
+  int line;
+
+  // filled in as the entry runs
+  int pid;
+  int fd;
+  uint64_t hash;
+  bool didFinish;
+} GoldenEntry;
+
+/**
+ * @brief Sent from each child process once its last frame is finished.
+ */
+typedef struct {
+  uint64_t hash;
+  uint32_t frames;
+} GoldenResult;
+
+/**
+ * @brief Run every ROM in a golden list in parallel and compare the hash of
+ *        its last frame against the stored value.
+ * 
+ * @param listPath the golden list
+ * @param shouldUpdate rewrite the list with the new hashes instead of comparing
+ * @return EXIT_SUCCESS if every entry matched
+ */
+int golden_run(char* listPath, bool shouldUpdate);
+
+/**
+ * @brief Called by the headless backend when the frame limit is reached.
+ */
+void golden_reportFrame(uint32_t* bmp, uint32_t frames);
+
+#endif
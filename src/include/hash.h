@@ -0,0 +1,88 @@
+/**
+ * hash.h
+ * 
+ * Fast 64-bit hashing of machine state and per-frame hash logs.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef HASH_H
+#define HASH_H
+
+#include "global.h"
+#include "config.h"
+#include "fileio.h"
+
+#define HASH_LOG_MAGIC 0x4853454E
+#define HASH_LOG_VERSION 1
+
+// bytes consumed by one accumulate step, and steps between scrambles
+#define HASH_STRIPE_SIZE 64
+#define HASH_STRIPES_PER_BLOCK 16
+#define HASH_SECRET_SIZE 192
+
+/**
+ * @brief Hash logs are this header followed by one 64-bit hash per frame,
+ *        counted from power-on.
+ */
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t romHash;
+  uint32_t frames;
+  uint32_t reserved;
+} HashLogHeader;
+
+/**
+ * @brief Hash a buffer with an XXH3-style stripe accumulator.
+ *        Results are identical with and without SSE2.
+ * 
+ * @param data the bytes to hash
+ * @param size the number of bytes
+ * @param seed chains hashes of separate buffers together
+ * @return the 64-bit hash
+ */
+uint64_t hash_compute(const uint8_t* data, size_t size, uint64_t seed);
+
+bool hash_startLog(char* path, uint64_t romHash);
+bool hash_loadReference(char* path);
+uint64_t hash_referenceRomHash(void);
+
+/**
+ * @brief Store the hash of a frame, discarding anything logged after it.
+ * @return false if the log can't grow to hold the frame
+ */
+bool hash_recordFrame(uint32_t frame, uint64_t hash);
+
+/**
+ * @brief Compare the hash of a frame against the reference log.
+ * @return false if the reference has a different hash for this frame
+ */
+bool hash_checkFrame(uint32_t frame, uint64_t hash);
+
+uint64_t hash_expectedFrame(uint32_t frame);
+bool hash_isActive(void);
+void hash_finish(void);
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * heatmap.h
+ * 
+ * Decaying heatmap of CPU bus reads, writes and instruction fetches.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef HEATMAP_H
+#define HEATMAP_H
+
+#include "global.h"
+#include "config.h"
+
+// one row per page, one pixel per address
+#define HEATMAP_WIDTH 256
+
+// $3000-$3FFF only mirrors the PPU registers, which are counted at
+// $2000-$2007, so those pages are left out to fit the remaining 240 rows
+#define HEATMAP_SKIPPED_PAGE 0x30
+#define HEATMAP_SKIPPED_PAGES 16
+
+// heat kept from the previous frame, out of 256
+#define HEATMAP_DECAY 224
+
+// brightness of an address accessed once in a frame, and per doubling after
+#define HEATMAP_BASE_LEVEL 48
+#define HEATMAP_LEVEL_STEP 20
+
+typedef enum {
+  HEATMAP_READ = 0,
+  HEATMAP_WRITE = 1,
+  HEATMAP_EXECUTE = 2,
+  HEATMAP_KINDS = 3
+} HeatmapKind;
+
+extern bool isHeatmapActive;
+
+/**
+ * @brief Start or stop counting. Counters are allocated the first time.
+ * @return false if the counters can't be allocated
+ */
+bool heatmap_setActive(bool isActive);
+
+/**
+ * @brief Count an access. Only call while isHeatmapActive is set.
+ */
+void heatmap_count(HeatmapKind kind, uint16_t addr);
+
+/**
+ * @brief Decay the heat by a frame, add this frame's accesses and draw the
+ *        map with writes in red, reads in green and fetches in blue.
+ */
+void heatmap_draw(uint32_t* bmp);
+
+#endif
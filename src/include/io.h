@@ -33,6 +33,11 @@
 #include "global.h"
 #include "config.h"
 #include "font.h"
+#include "scaler.h"
+
+#define IO_OVERLAY_MAX_CHARS 2048
+#define IO_OVERLAY_OPAQUE 0xFF000000
+#define IO_WAIT_TIMEOUT_MS 500
 
 extern uint32_t* BITMAP0;
 extern uint32_t* BITMAP1;
@@ -44,13 +49,34 @@ extern bool PANIC_MODE;
 
 void io_init(void);
 int io_pollInput(Keyboard* key);
+int io_waitInput(Keyboard* key, int timeoutMs);
 void io_render(void);
+void io_submitFrame(void);
+void io_configureBitmaps(void);
+void io_releaseBitmaps(void);
 void io_clear(void);
 void io_drawString(char* str, int screen);
 void io_drawChar(char chr, int num, uint32_t* bmp);
+void io_drawText(char* str, uint32_t* bmp, uint32_t atlas[128][64]);
+void io_drawGlyph(uint32_t* glyph, int num, uint32_t* bmp);
+void io_configureGlyphAtlas(void);
+void io_updateOverlay(char* str, int screen);
 void io_drawScreen(int screen,  uint32_t* pixels);
+void io_drawFilteredScreen(int screen, uint32_t* bmp, uint32_t* layer, uint32_t* pixels);
 void io_drawPixel(int x, int y, int screen, uint32_t color,  uint32_t* pixels);
 void io_panic(char* str);
 void io_kill(void);
 
+/**
+ * @brief Headless only: start timing the reported frame rate from now.
+ */
+void io_restartClock(void);
+
+/**
+ * @brief Register a function to run once when io_panic() is called, before
+ *        anything is shown or the program exits.
+ */
+void io_onPanic(void(*handler)(void));
+void io_runPanicHandler(void);
+
 #endif
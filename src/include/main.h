@@ -34,6 +34,8 @@
 #include "config.h"
 #include "nes.h"
 #include "io.h"
+#include "capture.h"
+#include "golden.h"
 
 /**
  * @brief Main entry point of program.
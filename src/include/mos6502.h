@@ -171,6 +171,29 @@ typedef struct {
   uint16_t bytecodeCount;
 } BytecodeProgram;
 
+// Set in TraceRecord.flags, zero for a fully recorded instruction
+#define TRACE_FLAG_NO_OPERAND 0x01
+#define TRACE_FLAG_NMI 0x02
+#define TRACE_FLAG_IRQ 0x04
+#define TRACE_FLAG_RESET 0x08
+#define TRACE_FLAG_EVENT (TRACE_FLAG_NMI | TRACE_FLAG_IRQ | TRACE_FLAG_RESET)
+
+// CPU state before an instruction, everything needed to rebuild its text trace
+typedef struct {
+  uint64_t cycles;
+  uint16_t pc;
+  uint16_t addr;
+  uint16_t pointer;
+  uint8_t data[3];
+  uint8_t a;
+  uint8_t x;
+  uint8_t y;
+  uint8_t p;
+  uint8_t s;
+  uint8_t value;
+  uint8_t flags;
+} TraceRecord;
+
 extern CPURegisters reg;
 
 /**
@@ -182,18 +205,34 @@ extern CPURegisters reg;
  * @param r the function to call for memory reads
  *          - Parameter 1 (uint16_t): the addr to perform the read
  *          - Return (uint8_t): the data stored at the address
+ * @param p the function to call for reads that must not have side effects,
+ *          such as the operand values recorded in traces
+ *          - Parameter 1 (uint16_t): the addr to peek at
+ *          - Return (uint8_t): the data a read would return
  */
-void mos6502_init(void(*w)(uint16_t, uint8_t), uint8_t(*r)(uint16_t));
+void mos6502_init(void(*w)(uint16_t, uint8_t), uint8_t(*r)(uint16_t), uint8_t(*p)(uint16_t));
 
 /**
  * Execute an instruction.
  * 
- * @param traceStr the location to write the instruction trace. Ignored if NULL
- *                 NOTE: Ensure that ample space is allocated. 128 bytes recommended.
+ * @param record the location to record the instruction for tracing. Ignored if NULL
+ *               NOTE: the cycle count is left for the caller to fill in.
  * @param c the function to call after the instruction is executed.
  *          - Contains a single uint8_t parameter containing the # of cycles elapsed
  */
-void mos6502_step(char* traceStr, void(*c)(uint8_t));
+void mos6502_step(TraceRecord* record, void(*c)(uint8_t));
+
+/**
+ * @brief Decode the instruction at pc into the bytecode cache, if caching is
+ *        enabled and it isn't cached yet.
+ *        NOTE: Only for addresses whose contents never change, such as ROM.
+ */
+void mos6502_cacheInstruction(uint16_t pc);
+
+/**
+ * @brief The number of bytes in an instruction, including the opcode.
+ */
+uint8_t mos6502_instructionLength(uint8_t opcode);
 
 /**
  * @brief Perform a reset. 
@@ -211,19 +250,44 @@ void mos6502_interrupt_nmi(void);
 void mos6502_interrupt_irq(void);
 
 /**
- * @brief Generate a CPU trace for an instruction.
- *        NOTE: Requires EXTIO
+ * @brief Record the CPU state before an instruction is executed.
+ * @param record The location for which the output will be stored.
+ * @param bytecode A pointer to the bytecode of the instruction
+ */
+void mos6502_recordTrace(TraceRecord* record, Bytecode* bytecode);
+
+/**
+ * @brief Generate the text CPU trace for a recorded instruction.
+ *        NOTE: Requires EXTIO, and only uses the tables from mos6502_configureTables()
+ * @param record The recorded instruction
  * @param traceStr The location for which the output will be stored.
  *                 NOTE: Ensure that ample space is allocated. 128 bytes recommended.
- * @param asmStr The assembly code of the instruction
- * @param bytecode A pointer to the bytecode of the instruction
  */
-void mos6502_generateTrace(char* traceStr, char* asmStr, Bytecode* bytecode);
+void mos6502_formatRecord(TraceRecord* record, char* traceStr);
+
+/**
+ * @brief Write the operand of an instruction in assembly syntax.
+ */
+void mos6502_formatOperand(char* operandStr, CPUAddressingMode addrMode, uint8_t* data, uint16_t pc);
+
+/**
+ * @brief Write an instruction in assembly syntax.
+ *        NOTE: Requires EXTIO
+ * @param bytecode The decoded instruction
+ * @param pc The address the instruction was decoded from
+ * @param assemblyStr The location for which the output will be stored. 64 bytes recommended.
+ */
+void mos6502_formatBytecode(Bytecode* bytecode, uint16_t pc, char* assemblyStr);
+
+/**
+ * @brief The assembly mnemonic of an opcode, e.g. "LDA".
+ */
+char* mos6502_mnemonicName(uint8_t opcode);
 
 /**
  * @brief Non-inlined function for external calls to mos6502_decode()
  */
-void mos6502_decode_external_wrapper(Bytecode* bytecode, char* assemblyResult, uint8_t* byteCount, uint16_t pc);
+void mos6502_decode_external_wrapper(Bytecode* bytecode, uint16_t pc);
 
 /**
  * @brief Configure tables for translating opcodes
@@ -233,7 +297,7 @@ void mos6502_configureTables(void);
 // INLINED FUNCTIONS -- should not be called outside of mos6502.c
 // These are called millions of times per second, so they are inlined
 // to avoid performance hits related to stack buildup/teardown
-force_inline void mos6502_decode(Bytecode* bytecode, char* assemblyResult, uint8_t* byteCount, uint16_t pc);
+force_inline void mos6502_decode(Bytecode* bytecode, uint16_t pc);
 force_inline void mos6502_setflag(CPUStatusFlag flag, uint8_t value);
 force_inline uint8_t mos6502_getflag(CPUStatusFlag flag);
 force_inline void mos6502_stack_push(uint8_t data);
@@ -241,5 +305,6 @@ force_inline uint8_t mos6502_stack_pop(void);
 force_inline uint16_t mos6502_read16(uint16_t addr);
 force_inline uint8_t mos6502_execute(Bytecode* bytecode);
 force_inline uint16_t mos6502_fetchValue(Bytecode* bytecode);
+force_inline uint8_t mos6502_byteCount(CPUAddressingMode addrMode);
 
 #endif
@@ -0,0 +1,90 @@
+/**
+ * movie.h
+ * 
+ * Per-frame input movies for deterministic record and replay.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVIE_H
+#define MOVIE_H
+
+#include "global.h"
+#include "config.h"
+#include "fileio.h"
+
+#define MOVIE_MAGIC 0x4D53454E
+#define MOVIE_VERSION 1
+
+// rewritten this often, so a killed run loses at most a few seconds
+#define MOVIE_FLUSH_FRAMES 600
+
+/**
+ * @brief Movie files are this header followed by one input byte per frame,
+ *        counted from power-on.
+ */
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t romHash;
+  uint32_t frames;
+  uint32_t reserved;
+} MovieHeader;
+
+/**
+ * @brief Start recording; the movie is written every MOVIE_FLUSH_FRAMES
+ *        frames and when the program exits.
+ */
+bool movie_startRecording(char* path, uint64_t romHash);
+
+/**
+ * @brief Load a movie for replay.
+ * @return false if the file is missing or not a movie
+ */
+bool movie_startReplay(char* path);
+
+/**
+ * @brief Store the input for a frame, discarding anything recorded after it.
+ *        Frames go back in time after a rewind or a loaded state.
+ * @return false if the movie can't grow to hold the frame
+ */
+bool movie_recordFrame(uint32_t frame, uint8_t input);
+
+/**
+ * @brief Fetch the input for a frame.
+ * @return false once the movie has run out of frames
+ */
+bool movie_replayFrame(uint32_t frame, uint8_t* input);
+
+void movie_finish(void);
+bool movie_isRecording(void);
+bool movie_isReplaying(void);
+uint64_t movie_romHash(void);
+
+/**
+ * @brief Whether the replayed movie presses anything before a frame.
+ */
+bool movie_hasInputBefore(uint32_t frame);
+
+#endif
@@ -37,16 +37,75 @@
 #include "io.h"
 #include "nesppu.h"
 #include "nesjoypad.h"
+#include "capture.h"
+#include "nesshm.h"
+#include "rewind.h"
+#include "movie.h"
+#include "hash.h"
+#include "tracelog.h"
+#include "flight.h"
+#include "profile.h"
+#include "timer.h"
+#include "perfcount.h"
+#include "timeline.h"
+#include "heatmap.h"
+#include "cdl.h"
+#include "framegraph.h"
+
+#define NES_STATE_MAGIC 0x5453454E
+#define NES_STATE_VERSION 1
+#define NES_QUICKSAVE_PATH "./debug/quicksave.state"
+#define NES_IDLE_LOOP_SIZE 16
+#define NES_BOOTCACHE_PATH "./debug/boot-%016llX-%016llX.state"
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t size;
+  uint32_t frame;
+  CPURegisters cpu;
+  int32_t cpuCycles;
+  bool resetPPUStat;
+  uint8_t ram[0x800];
+  uint8_t ppuIO[0x08];
+  uint8_t apuIO[0x20];
+  NESPPUState ppu;
+  NESJoypadState joypad;
+} NESState;
+
+// Start of the loop iteration being watched by nes_skipIdleLoop()
+typedef struct {
+  CPURegisters reg;
+  uint8_t ppustatus;
+  int32_t cycles;
+} NESIdleLoop;
 
 void nes_init(char* fsRoot);
 void nes_start(void);
 void nes_disassemble(char* filePath);
 void nes_configureMemory(void);
+void nes_boot(uint32_t cyclesPerInterval);
+void nes_emulateFrame(uint32_t cyclesPerInterval, bool isShown);
+void nes_runFrame(uint32_t cyclesPerInterval, bool shouldTrace);
+void nes_runAhead(uint32_t cyclesPerInterval);
+void nes_skipIdleLoop(uint32_t cyclesPerInterval);
+void nes_recordFlight(uint8_t flags);
+void nes_interruptNmi(void);
+void nes_dumpFlight(void);
+uint64_t nes_cycleCount(void);
 uint8_t nes_cpuRead(uint16_t addr);
+uint8_t nes_cpuPeek(uint16_t addr);
 void nes_cpuWrite(uint16_t addr, uint8_t data);
 void nes_finishedInstruction(uint8_t cycles);
 void nes_generateMetrics(char* outputStr);
 void nes_toggleJoypad(Keyboard key, int status);
 void nes_debugCPU(void);
+void nes_saveState(NESState* state);
+bool nes_loadState(NESState* state);
+bool nes_rewindFrame(void);
+uint64_t nes_hashFrame(void);
+void nes_checkFrameHash(void);
+bool nes_saveStateToFile(char* path);
+bool nes_loadStateFromFile(char* path);
 
 #endif
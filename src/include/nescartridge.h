@@ -67,6 +67,7 @@ typedef struct {
   uint8_t* chrRom;
   uint8_t* instRom;
   uint8_t* pRom;
+  uint64_t romHash;
 } INES;
 
 typedef struct {
@@ -79,5 +80,6 @@ INES nescartridge_loadRom(char* romPath);
 bool nescartridge_isRomFile(char* fileName);
 bool nescartridge_selectRom(char selectedRomPath[FILEIO_MAX_PATH_SIZE]);
 INES nescartridge_parseRom(FileBinary* bin);
+uint64_t nescartridge_hashRom(FileBinary* bin);
 
 #endif
@@ -26,6 +26,10 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+
+#ifndef NESJOYPAD_H
+#define NESJOYPAD_H
+
 #include "global.h"
 #include "config.h"
 
@@ -40,6 +44,19 @@ typedef enum {
   NJP_A       = BIT_MASK_0
 } NESJoypadButton;
 
+typedef struct {
+  uint8_t buttons;
+  uint8_t shiftIndex;
+  bool strobeMode;
+} NESJoypadState;
+
 uint8_t nesjoypad_get(void);
+uint8_t nesjoypad_peek(void);
 void nesjoypad_set(NESJoypadButton button, bool enabled);
 void nesjoypad_setStrobeMode(bool mode);
+uint8_t nesjoypad_getState(void);
+void nesjoypad_setState(uint8_t buttons);
+void nesjoypad_saveState(NESJoypadState* joypad);
+void nesjoypad_loadState(NESJoypadState* joypad);
+
+#endif
@@ -37,6 +37,9 @@
 #include "config.h"
 #include "io.h"
 #include "nescartridge.h"
+#include "hash.h"
+#include "timer.h"
+#include "timeline.h"
 
 #define GET_ppuctrl_nametable(val) (val & 3)
 #define GET_ppuctrl_vraminc GET_bit2
@@ -99,6 +102,19 @@ typedef struct {
   uint8_t ppuDataBuffer;
 } PPURegisters;
 
+typedef struct {
+  PPURegisters reg;
+  PPURegisters scanlineReg[262];
+  uint8_t nametable[4][960];
+  uint8_t attrTable[4][64];
+  uint8_t vram[0x400];
+  uint8_t palette[0x100];
+  uint8_t oam[256];
+  uint32_t cycleCount;
+  int32_t lastScanline;
+  bool didGenerateNmi;
+} NESPPUState;
+
 static const uint32_t colors[64] =
 {
 0x757575, 0x271B8F, 0x0000AB, 0x47009F, 0x8F0077, 0xAB0013, 0xA70000, 0x7F0B00,
@@ -128,5 +144,11 @@ void nesppu_drawBkgTileFromPatternTable(uint16_t id, uint16_t bankOffset, uint8_
 void nesppu_drawOutlinedSquare(uint32_t color, uint8_t size, uint8_t x, uint8_t y);
 uint8_t nesppu_read(uint16_t addr);
 void nesppu_write(uint16_t addr, uint8_t data);
+uint32_t nesppu_cyclesUntilEvent(void);
+void nesppu_skip(uint32_t cycles);
+void nesppu_setRenderSkip(bool shouldSkip);
+void nesppu_saveState(NESPPUState* state);
+void nesppu_loadState(NESPPUState* state);
+uint64_t nesppu_hashState(uint64_t seed);
 
 #endif
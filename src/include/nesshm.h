@@ -0,0 +1,74 @@
+/**
+ * nesshm.h
+ * 
+ * Export frames and work RAM through POSIX shared memory.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NESSHM_H
+#define NESSHM_H
+
+#include "global.h"
+#include "config.h"
+#include "nesppu.h"
+#include "nesjoypad.h"
+#include <stdatomic.h>
+
+#define NESSHM_MAGIC 0x4D485345
+#define NESSHM_VERSION 1
+#define NESSHM_RAM_SIZE 0x800
+
+/**
+ * Layout of the shared memory segment.
+ * 
+ * The emulator publishes a frame using a seqlock: `sequence` is odd while
+ * `frame`, `joypad`, `ram` and `framebuffer` are being written, and even once
+ * they are consistent. Readers should load `sequence`, copy what they need,
+ * then load `sequence` again and retry if it changed or was odd.
+ * 
+ * Consumers may drive the joypad by writing `input` and setting
+ * `inputEnabled`, which is applied at the start of the next frame.
+ */
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t width;
+  uint32_t height;
+  atomic_uint sequence;
+  uint32_t frame;
+  uint8_t joypad;
+  _Atomic uint8_t input;
+  _Atomic uint8_t inputEnabled;
+  uint8_t reserved;
+  uint8_t ram[NESSHM_RAM_SIZE];
+  uint32_t framebuffer[DISPLAY_PIXELS];
+} NESSharedMemory;
+
+bool nesshm_init(char* name);
+void nesshm_publishFrame(uint32_t frame, uint8_t* ram, uint32_t* bmp);
+void nesshm_applyInput(void);
+void nesshm_release(void);
+
+#endif
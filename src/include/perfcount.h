@@ -0,0 +1,73 @@
+/**
+ * perfcount.h
+ * 
+ * Host hardware performance counters around emulation, via perf_event_open.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PERFCOUNT_H
+#define PERFCOUNT_H
+
+#include "global.h"
+#include "config.h"
+
+// perf_event_open is Linux-only, anywhere else every counter is unavailable
+#if defined(__linux__) && !SUPPRESS_EXTIO
+#define PERFCOUNT_SUPPORTED TRUE
+#else
+#define PERFCOUNT_SUPPORTED FALSE
+#endif
+
+typedef enum {
+  PERFCOUNT_INSTRUCTIONS = 0,
+  PERFCOUNT_CYCLES = 1,
+  PERFCOUNT_BRANCH_MISSES = 2,
+  PERFCOUNT_L1D_MISSES = 3,
+  PERFCOUNT_COUNT = 4
+} PerfCounter;
+
+/**
+ * @brief Open whichever counters the host allows. Counters that can't be
+ *        opened are reported and left out. The totals are printed when the
+ *        program exits.
+ * @return true if at least one counter is open
+ */
+bool perfcount_init(void);
+
+/**
+ * @brief Start counting for an emulated frame.
+ */
+void perfcount_begin(void);
+
+/**
+ * @brief Stop counting for an emulated frame.
+ * @param instructions the number of guest instructions in the frame
+ */
+void perfcount_end(uint32_t instructions);
+
+bool perfcount_isActive(void);
+void perfcount_finish(void);
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * profile.h
+ * 
+ * Guest-level execution profiler with per-address and per-opcode counters.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "global.h"
+#include "mos6502.h"
+
+#define PROFILE_REPORT_PATH "./debug/profile.txt"
+#define PROFILE_REPORT_ROWS 32
+#define PROFILE_STACK_SIZE 256
+
+// A routine entered by JSR or an interrupt that hasn't returned yet
+typedef struct {
+  uint16_t addr;
+  uint64_t entryCycles;
+} ProfileFrame;
+
+/**
+ * @brief Allocate the counters. The report is written when the program exits.
+ */
+bool profile_init(void);
+
+/**
+ * @brief Count an executed instruction.
+ * @param pc the address of the instruction
+ * @param nextPc the address of the next instruction, the callee for a JSR
+ * @param opcode the first byte of the instruction
+ * @param cycles the cycles the instruction took
+ */
+void profile_record(uint16_t pc, uint16_t nextPc, uint8_t opcode, uint32_t cycles);
+
+/**
+ * @brief Treat the handler at addr as a routine called after the instruction
+ *        being executed is counted.
+ */
+void profile_interrupt(uint16_t addr);
+
+void profile_endFrame(void);
+bool profile_isActive(void);
+void profile_finish(void);
+
+#endif
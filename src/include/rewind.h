@@ -0,0 +1,64 @@
+/**
+ * rewind.h
+ * 
+ * Frame history stored as XOR deltas against the newest snapshot.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef REWIND_H
+#define REWIND_H
+
+#include "global.h"
+#include "config.h"
+
+// a literal run ends once this many unchanged bytes follow it
+#define REWIND_MIN_ZERO_RUN 4
+
+/**
+ * @brief Allocate the history ring.
+ * 
+ * @param stateSize the size of each snapshot in bytes
+ * @param bufferSize the number of bytes reserved for deltas
+ * @return true if the buffers could be allocated
+ */
+bool rewind_init(size_t stateSize, size_t bufferSize);
+
+/**
+ * @brief Record a snapshot, evicting the oldest history if the ring is full.
+ */
+void rewind_push(uint8_t* state);
+
+/**
+ * @brief Step back one snapshot.
+ * 
+ * @param state receives the snapshot recorded before the newest one
+ * @return false if there is no older snapshot
+ */
+bool rewind_pop(uint8_t* state);
+
+bool rewind_isActive(void);
+uint32_t rewind_frameCount(void);
+
+#endif
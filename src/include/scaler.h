@@ -0,0 +1,71 @@
+/**
+ * scaler.h
+ * 
+ * Pixel-art scaling filters used when presenting frames.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SCALER_H
+#define SCALER_H
+
+#include "global.h"
+#include "config.h"
+
+/**
+ * @brief Scale an image by 2x using Scale2x (EPX).
+ * 
+ * @param src the source image
+ * @param width the width of the source image
+ * @param height the height of the source image
+ * @param dst the location of the top-left output pixel
+ * @param pitch the number of pixels per row in dst
+ */
+void scaler_scale2x(uint32_t* src, int width, int height, uint32_t* dst, int pitch);
+
+/**
+ * @brief Scale an image by 3x using Scale3x (AdvMAME3x).
+ *        Parameters are the same as scaler_scale2x().
+ */
+void scaler_scale3x(uint32_t* src, int width, int height, uint32_t* dst, int pitch);
+
+/**
+ * @brief Check that the vectorized filters match the scalar reference
+ *        implementations pixel for pixel.
+ * @return true if all outputs match
+ */
+bool scaler_verify(void);
+
+/**
+ * @brief Use the scalar reference implementations from now on.
+ */
+void scaler_disableVectorized(void);
+
+/**
+ * @brief Reference implementations the vectorized filters are checked against.
+ */
+void scaler_scale2xScalar(uint32_t* src, int width, int height, uint32_t* dst, int pitch);
+void scaler_scale3xScalar(uint32_t* src, int width, int height, uint32_t* dst, int pitch);
+
+#endif
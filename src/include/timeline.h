@@ -0,0 +1,73 @@
+/**
+ * timeline.h
+ * 
+ * Chrome trace-event timeline of emulated frames.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include "global.h"
+#include "config.h"
+
+// Host time and emulated time are shown as separate processes
+#define TIMELINE_PID_HOST 1
+#define TIMELINE_PID_EMULATED 2
+
+// Interrupt handlers can outlast the frame, so they don't nest inside it
+#define TIMELINE_TID_MAIN 1
+#define TIMELINE_TID_INTERRUPT 2
+
+/**
+ * @brief Start a timeline in the Chrome trace-event JSON format (viewable in
+ *        Perfetto), replacing any existing file. The file is closed when the
+ *        program exits.
+ * @param frequency the CPU frequency, to convert cycles to emulated time
+ * @param cycle returns the number of CPU cycles since power-on
+ */
+bool timeline_open(char* path, long frequency, uint64_t(*cycle)(void));
+
+/**
+ * @brief Open a span on the host timeline, and also on the emulated one if
+ *        isEmulated is set.
+ * @param tid the track within each timeline, e.g. TIMELINE_TID_MAIN
+ */
+void timeline_begin(char* name, int tid, bool isEmulated);
+
+/**
+ * @brief Close the span opened last on the same track.
+ */
+void timeline_end(char* name, int tid, bool isEmulated);
+
+/**
+ * @brief Mark a point in time on both timelines.
+ */
+void timeline_instant(char* name);
+
+bool timeline_isActive(void);
+void timeline_finish(void);
+
+#endif
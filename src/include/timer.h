@@ -0,0 +1,100 @@
+/**
+ * timer.h
+ * 
+ * Scoped timers for breaking frame time down by subsystem.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include "global.h"
+
+// timers need a host clock and stdio, so they are left out if either is suppressed
+#define TIMER_ACTIVE (ENABLE_TIMERS && !SUPPRESS_TIMING && !SUPPRESS_EXTIO)
+
+#define TIMER_HISTORY 1024
+#define TIMER_CALIBRATION_US 20000
+
+// Nested sections include the time of the sections inside them
+typedef enum {
+  TIMER_CPU = 0,         // nes_runFrame, including the PPU
+  TIMER_PPU = 1,         // nesppu_step, including drawing
+  TIMER_BACKGROUND = 2,
+  TIMER_SPRITES = 3,
+  TIMER_RENDER = 4,      // io_render and io_submitFrame
+  TIMER_INPUT = 5,
+  TIMER_SLEEP = 6,
+  TIMER_COUNT = 7
+} TimerSection;
+
+#if (TIMER_ACTIVE)
+
+#define TIMER_BEGIN(section) uint64_t timerStart_##section = timer_now()
+#define TIMER_END(section) timer_add(section, timer_now() - timerStart_##section)
+
+/**
+ * @brief Calibrate the clock and clear all sections. The stats are printed
+ *        when the program exits.
+ */
+void timer_init(void);
+
+/**
+ * @brief Close the current frame, storing the time of each section.
+ */
+void timer_endFrame(void);
+
+/**
+ * @brief Write min/avg/p99 for each section, in microseconds per frame.
+ */
+void timer_format(char* str);
+
+void timer_add(TimerSection section, uint64_t ticks);
+void timer_finish(void);
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+
+static force_inline uint64_t timer_now(void) {
+  return __rdtsc();
+}
+#else
+#include <time.h>
+
+static force_inline uint64_t timer_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t) ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+#endif
+
+#else
+
+#define TIMER_BEGIN(section)
+#define TIMER_END(section)
+
+#endif
+
+#endif
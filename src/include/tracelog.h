@@ -0,0 +1,68 @@
+/**
+ * tracelog.h
+ * 
+ * Buffered instruction trace writer.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ * 
+ * Copyright (c) 2023 Noah Sadir
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TRACELOG_H
+#define TRACELOG_H
+
+#include "global.h"
+#include "config.h"
+#include "mos6502.h"
+
+#define TRACELOG_MAGIC 0x5254454E
+#define TRACELOG_VERSION 1
+#define TRACELOG_TEXT_PATH "./debug/trace.log"
+#define TRACELOG_BINARY_PATH "./debug/trace.bin"
+#define TRACELOG_BUFFER_RECORDS 16384
+#define TRACELOG_TEXT_BUFFER (1 << 20)
+
+/**
+ * @brief Binary traces are this header followed by one TraceRecord per
+ *        instruction, in host byte order.
+ */
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t recordSize;
+  uint32_t reserved;
+} TraceLogHeader;
+
+/**
+ * @brief Start a trace, replacing any existing file. The trace is flushed
+ *        when the program exits.
+ */
+bool tracelog_open(char* path, TraceFormat format);
+
+/**
+ * @brief Append an instruction to the trace.
+ */
+void tracelog_write(TraceRecord* record);
+
+void tracelog_finish(void);
+
+#endif
@@ -0,0 +1,233 @@
+/**
+ * io.c
+ * 
+ * Host-independent drawing shared by every I/O backend.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/io.h"
+
+uint32_t* BITMAP0;
+uint32_t* BITMAP1;
+uint32_t* BITMAP2;
+uint32_t* BITMAP3;
+char* OVERLAY_MSG;
+char* PANIC_MSG;
+bool PANIC_MODE;
+
+uint32_t glyphAtlas[128][64];
+uint32_t overlayAtlas[128][64];
+uint32_t* overlayLayer;
+char overlayCache[IO_OVERLAY_MAX_CHARS];
+int overlayScreen = -1;
+uint32_t* filterInput;
+void(*panicHandler)(void) = NULL;
+
+void io_configureBitmaps(void) {
+  OVERLAY_MSG = "";
+  PANIC_MSG = "";
+  PANIC_MODE = false;
+  BITMAP0 = malloc(sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height);
+  BITMAP1 = malloc(sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height);
+  BITMAP2 = malloc(sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height);
+  BITMAP3 = malloc(sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height);
+  overlayLayer = calloc(CONFIG_DISPLAY.width * CONFIG_DISPLAY.height, sizeof(uint32_t));
+  filterInput = malloc(sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height);
+  io_configureGlyphAtlas();
+
+  // a wrong vector path only costs speed once the scalar one takes over
+  if (CONFIG_DISPLAY.filter != FILTER_NONE && !scaler_verify()) {
+#if (!SUPPRESS_EXTIO)
+    fprintf(stderr, "SCALER: vectorized filter does not match reference output, using scalar filter\n");
+#endif
+    scaler_disableVectorized();
+  }
+}
+
+void io_releaseBitmaps(void) {
+  free(BITMAP0);
+  free(BITMAP1);
+  free(BITMAP2);
+  free(BITMAP3);
+  free(overlayLayer);
+  free(filterInput);
+}
+
+void io_drawString(char* str, int screen) {
+  uint32_t* bmp;
+
+  if (screen == 0) {
+    bmp = BITMAP0;
+  } else if (screen == 1) {
+    bmp = BITMAP1;
+  } else if (screen == 2) {
+    bmp = BITMAP2;
+  } else {
+    bmp = BITMAP3;
+  }
+
+  io_drawText(str, bmp, glyphAtlas);
+}
+
+void io_drawText(char* str, uint32_t* bmp, uint32_t atlas[128][64]) {
+  int charPos = 0;  
+  int charsPerRow = CONFIG_DISPLAY.width / 8;
+  for (int i = 0; str[i] != '\0'; i++) {
+    if (str[i] == '\n') {
+      charPos = charPos - (charPos % charsPerRow) + charsPerRow;
+    } else if (str[i] == '\t') {
+      charPos += 1;
+    } else {
+      io_drawGlyph(atlas[str[i] & 127], charPos, bmp);
+      charPos += 1;
+    }
+  }
+}
+
+void io_drawChar(char chr, int charPos, uint32_t* bmp) {
+  io_drawGlyph(glyphAtlas[chr & 127], charPos, bmp);
+}
+
+void io_drawGlyph(uint32_t* glyph, int charPos, uint32_t* bmp) {
+  int charsPerRow = CONFIG_DISPLAY.width / 8;
+  int startX = (charPos % charsPerRow) * 8;
+  int startY = (charPos / charsPerRow) * 8;
+
+  // ignore characters which would fall below the bottom of the screen
+  if (startY + 8 > CONFIG_DISPLAY.height) return;
+
+  for (int row = 0; row < 8; row++) {
+    memcpy(bmp + ((startY + row) * CONFIG_DISPLAY.width) + startX, glyph + (row * 8), sizeof(uint32_t) * 8);
+  }
+}
+
+void io_configureGlyphAtlas(void) {
+  // expand each 1bpp character once so text can be copied a row at a time
+  // overlay glyphs carry an alpha byte to mark them as opaque when composited
+  for (int chr = 0; chr < 128; chr++) {
+    for (int i = 0; i < 64; i++) {
+      glyphAtlas[chr][i] = ((font[chr] >> (63 - i)) & 1) ? 0xFFFFFF : 0x000000;
+      overlayAtlas[chr][i] = glyphAtlas[chr][i] | IO_OVERLAY_OPAQUE;
+    }
+  }
+}
+
+void io_updateOverlay(char* str, int screen) {
+  // text changes at most a few times per second, so only redraw layer on change
+  if (screen == overlayScreen && strncmp(str, overlayCache, IO_OVERLAY_MAX_CHARS - 1) == 0) return;
+
+  memset(overlayLayer, 0, sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height);
+  io_drawText(str, overlayLayer, overlayAtlas);
+
+  strncpy(overlayCache, str, IO_OVERLAY_MAX_CHARS - 1);
+  overlayCache[IO_OVERLAY_MAX_CHARS - 1] = '\0';
+  overlayScreen = screen;
+}
+
+void io_drawScreen(int screen, uint32_t* pixels) {
+  uint32_t* bmp;
+
+  if (screen == 0) {
+    bmp = BITMAP0;
+  } else if (screen == 1) {
+    bmp = BITMAP1;
+  } else if (screen == 2) {
+    bmp = BITMAP2;
+  } else {
+    bmp = BITMAP3;
+  }
+
+  // composite overlay text on top of the screen it belongs to
+  uint32_t* layer = (screen == overlayScreen) ? overlayLayer : NULL;
+
+  if (CONFIG_DISPLAY.filter != FILTER_NONE) {
+    io_drawFilteredScreen(screen, bmp, layer, pixels);
+    return;
+  }
+
+  for (int x = 0; x < CONFIG_DISPLAY.width; x++) {
+    for (int y = 0; y < CONFIG_DISPLAY.height; y++) {
+      int pos = (y * CONFIG_DISPLAY.width) + x;
+      uint32_t color = (layer != NULL && (layer[pos] & IO_OVERLAY_OPAQUE)) ? layer[pos] & 0xFFFFFF : bmp[pos];
+      io_drawPixel(x, y, screen, color, pixels);
+    }
+  }
+}
+
+void io_drawFilteredScreen(int screen, uint32_t* bmp, uint32_t* layer, uint32_t* pixels) {
+  int size = CONFIG_DISPLAY.width * CONFIG_DISPLAY.height;
+  uint32_t* src = bmp;
+
+  // the filter looks at neighboring pixels, so text has to be in the input
+  if (layer != NULL) {
+    for (int pos = 0; pos < size; pos++) {
+      filterInput[pos] = (layer[pos] & IO_OVERLAY_OPAQUE) ? layer[pos] & 0xFFFFFF : bmp[pos];
+    }
+    src = filterInput;
+  }
+
+  int screenX = (screen % 2 == 0) ? 0 : (CONFIG_DISPLAY.width * CONFIG_DISPLAY.scale);
+  int screenY = (screen < 2) ? 0 : (CONFIG_DISPLAY.height * CONFIG_DISPLAY.scale);
+  int pixelsWidth = CONFIG_DISPLAY.width * CONFIG_DISPLAY.scale * (CONFIG_DISPLAY.screens == 1 ? 1 : 2);
+  uint32_t* dst = pixels + (screenY * pixelsWidth) + screenX;
+
+  if (CONFIG_DISPLAY.filter == FILTER_SCALE2X) {
+    scaler_scale2x(src, CONFIG_DISPLAY.width, CONFIG_DISPLAY.height, dst, pixelsWidth);
+  } else {
+    scaler_scale3x(src, CONFIG_DISPLAY.width, CONFIG_DISPLAY.height, dst, pixelsWidth);
+  }
+}
+
+void io_drawPixel(int x, int y, int screen, uint32_t color, uint32_t* pixels) {
+  // find starting x & y in screen
+  int screenX = (screen % 2 == 0) ? 0 : (CONFIG_DISPLAY.width * CONFIG_DISPLAY.scale);
+  int screenY = (screen < 2) ? 0 : (CONFIG_DISPLAY.height * CONFIG_DISPLAY.scale);
+  
+  int pixelsWidth = CONFIG_DISPLAY.width * CONFIG_DISPLAY.scale * (CONFIG_DISPLAY.screens == 1 ? 1 : 2);
+
+  // find starting x & y for pixel
+  int pixelX = screenX + (x * CONFIG_DISPLAY.scale);
+  int pixelY = screenY + (y * CONFIG_DISPLAY.scale);
+
+  for (int row = 0; row < CONFIG_DISPLAY.scale; row++) {
+    for (int col = 0; col < CONFIG_DISPLAY.scale; col++) {
+      pixels[((pixelY + row) * pixelsWidth) + pixelX + col] = color;
+    }
+  }
+}
+
+void io_clear(void) {
+  OVERLAY_MSG = "";
+  uint32_t* bmp;
+
+  for (int screen = 0; screen < CONFIG_DISPLAY.screens; screen++) {
+    if (screen == 0) {
+      bmp = BITMAP0;
+    } else if (screen == 1) {
+      bmp = BITMAP1;
+    } else if (screen == 2) {
+      bmp = BITMAP2;
+    } else {
+      bmp = BITMAP3;
+    }
+    for (int i = 0; i < (CONFIG_DISPLAY.width * CONFIG_DISPLAY.height); i += 1) {
+      bmp[i] = 0x000000;
+    }
+  }
+  io_render();
+}
+
+void io_onPanic(void(*handler)(void)) {
+  panicHandler = handler;
+}
+
+void io_runPanicHandler(void) {
+  // cleared first so a panic inside the handler can't loop
+  void(*handler)(void) = panicHandler;
+  panicHandler = NULL;
+  if (handler != NULL) {
+    handler();
+  }
+}
@@ -0,0 +1,201 @@
+/**
+ * Implementation of I/O without a display
+ * 
+ * io_headless.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/global.h"
+
+#if (IO_LIBRARY == HEADLESS)
+#include "include/io.h"
+#include "include/video.h"
+#include "include/golden.h"
+
+#if (!SUPPRESS_EXTIO)
+#include <unistd.h>
+#endif
+
+typedef struct {
+  uint32_t frame;
+  Keyboard key;
+  int status;
+} ScriptedInput;
+
+// indexed by Keyboard value
+char* scriptKeyNames[] = {
+  "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "Q", "W", "E", "R", "T",
+  "Y", "U", "I", "O", "P", "A", "S", "D", "F", "G", "H", "J", "K", "L", "Z",
+  "X", "C", "V", "B", "N", "M", "LSHIFT", "RSHIFT", "RETURN", "FN", "LCTRL",
+  "LALT", "LCMD", "SPACE", "RCMD", "RALT", "RCTRL", "UP", "LEFT", "DOWN",
+  "RIGHT", "CAPSLK", "TAB", "BACKSP", "TILDE", "MINUS", "PLUS", "LBRACK",
+  "RBRACK", "PIPE", "COLON", "QUOTE", "LCHEV", "RCHEV", "QMARK", "F1", "F2",
+  "F3", "F4", "F5", "F6", "F7", "F8", "F9", "F10", "F11", "F12", "ESCAPE"
+};
+
+FILE* videoFile = NULL;
+uint8_t* videoFrame = NULL;
+ScriptedInput* scriptedInputs = NULL;
+uint32_t scriptedInputCount = 0;
+uint32_t scriptedInputIndex = 0;
+uint32_t submittedFrames = 0;
+
+#if (!SUPPRESS_TIMING)
+struct timeval headlessStart;
+#endif
+
+bool convertScriptKey(char* name, Keyboard* key) {
+  for (int i = 0; i <= K_ESCAPE; i++) {
+    if (!strcmp(name, scriptKeyNames[i])) {
+      *key = (Keyboard)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+void io_loadInputScript(char* path) {
+#if (!SUPPRESS_EXTIO)
+  // each line is formatted as `<frame> <key> <down|up>`, '#' starts a comment
+  char* scriptStr;
+  if (fileio_readFileAsString(path, &scriptStr) == -1) {
+    fprintf(stderr, "ERROR: Unable to read input script '%s'\n", path);
+    exit(EXIT_FAILURE);
+  }
+
+  uint32_t capacity = 64;
+  scriptedInputs = malloc(sizeof(ScriptedInput) * capacity);
+  int lineNumber = 0;
+  char* line = strtok(scriptStr, "\n");
+  while (line != NULL) {
+    lineNumber += 1;
+    uint32_t frame;
+    char keyName[16];
+    char state[8];
+    if (line[0] != '#' && sscanf(line, "%u %15s %7s", &frame, keyName, state) == 3) {
+      ScriptedInput input;
+      input.frame = frame;
+      input.status = !strcmp(state, "down") ? 1 : (!strcmp(state, "up") ? -1 : 0);
+      if (!convertScriptKey(keyName, &input.key) || input.status == 0) {
+        fprintf(stderr, "ERROR: Invalid input on line %d of '%s'\n", lineNumber, path);
+        exit(EXIT_FAILURE);
+      }
+      if (scriptedInputCount == capacity) {
+        capacity *= 2;
+        scriptedInputs = realloc(scriptedInputs, sizeof(ScriptedInput) * capacity);
+      }
+      scriptedInputs[scriptedInputCount] = input;
+      scriptedInputCount += 1;
+    }
+    line = strtok(NULL, "\n");
+  }
+  free(scriptStr);
+#endif
+}
+
+void io_restartClock(void) {
+  #if (!SUPPRESS_TIMING)
+    gettimeofday(&headlessStart, 0);
+  #endif
+}
+
+void io_init(void) {
+  io_configureBitmaps();
+  io_restartClock();
+
+  #if (!SUPPRESS_EXTIO)
+    if (CONFIG_HEADLESS.videoPath[0] != '\0') {
+      if (!strcmp(CONFIG_HEADLESS.videoPath, "-")) {
+        // keep stdout for frames and send any other output to stderr
+        videoFile = fdopen(dup(STDOUT_FILENO), "wb");
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+      } else {
+        videoFile = fopen(CONFIG_HEADLESS.videoPath, "wb");
+      }
+      if (videoFile == NULL) {
+        fprintf(stderr, "ERROR: Unable to open video output '%s'\n", CONFIG_HEADLESS.videoPath);
+        exit(EXIT_FAILURE);
+      }
+      videoFrame = malloc(video_frameSize(CONFIG_HEADLESS.videoFormat, CONFIG_DISPLAY.width, CONFIG_DISPLAY.height));
+      video_writeStreamHeader(videoFile, CONFIG_HEADLESS.videoFormat, CONFIG_DISPLAY.width, CONFIG_DISPLAY.height);
+    }
+
+    if (CONFIG_HEADLESS.inputPath[0] != '\0') {
+      io_loadInputScript(CONFIG_HEADLESS.inputPath);
+    }
+  #endif
+}
+
+int io_pollInput(Keyboard* key) {
+  // deliver at most one scripted event per poll, same as a real keyboard
+  if (scriptedInputIndex < scriptedInputCount && scriptedInputs[scriptedInputIndex].frame <= submittedFrames) {
+    *key = scriptedInputs[scriptedInputIndex].key;
+    int status = scriptedInputs[scriptedInputIndex].status;
+    scriptedInputIndex += 1;
+    return status;
+  }
+  return 0;
+}
+
+int io_waitInput(Keyboard* key, int timeoutMs) {
+  // only scripted input can arrive, so there's nothing to wake up for
+  int status = io_pollInput(key);
+  #if (!SUPPRESS_TIMING)
+    if (status == 0) {
+      usleep(timeoutMs * 1000);
+    }
+  #endif
+  return status;
+}
+
+void io_render(void) {
+  // nothing to present without a display
+}
+
+void io_submitFrame(void) {
+  #if (!SUPPRESS_EXTIO)
+    if (videoFile != NULL) {
+      uint32_t size = video_encodeFrame(CONFIG_HEADLESS.videoFormat, BITMAP0, CONFIG_DISPLAY.width, CONFIG_DISPLAY.height, videoFrame);
+      fwrite(videoFrame, 1, size, videoFile);
+    }
+  #endif
+
+  submittedFrames += 1;
+  if (CONFIG_HEADLESS.frameLimit > 0 && submittedFrames >= CONFIG_HEADLESS.frameLimit) {
+    golden_reportFrame(BITMAP0, submittedFrames);
+    io_kill();
+    exit(EXIT_SUCCESS);
+  }
+}
+
+void io_kill(void) {
+  #if (!SUPPRESS_EXTIO)
+    if (videoFile != NULL) {
+      fclose(videoFile);
+      videoFile = NULL;
+    }
+
+    #if (!SUPPRESS_TIMING)
+      struct timeval now;
+      gettimeofday(&now, 0);
+      double seconds = (now.tv_sec - headlessStart.tv_sec) + ((now.tv_usec - headlessStart.tv_usec) / 1000000.0);
+      fprintf(stderr, "HEADLESS: %u frames in %.3f s (%.1f fps)\n", submittedFrames, seconds, seconds > 0 ? submittedFrames / seconds : 0);
+    #endif
+  #endif
+
+  free(videoFrame);
+  free(scriptedInputs);
+  io_releaseBitmaps();
+}
+
+void io_panic(char* str) {
+  io_runPanicHandler();
+  #if (!SUPPRESS_EXTIO)
+    fprintf(stderr, "panic! %s\n", str);
+  #endif
+  io_kill();
+  exit(EXIT_FAILURE);
+}
+#endif
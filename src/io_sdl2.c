@@ -7,18 +7,12 @@
  * @date 2023-07-30
  */
 
+#include "include/global.h"
+
 #if (IO_LIBRARY == SDL2)
 #include <SDL2/SDL.h>
 #include "include/io.h"
 
-uint32_t* BITMAP0;
-uint32_t* BITMAP1;
-uint32_t* BITMAP2;
-uint32_t* BITMAP3;
-char* OVERLAY_MSG;
-char* PANIC_MSG;
-bool PANIC_MODE;
-
 SDL_Window* window;
 SDL_Surface* surface;
 
@@ -74,6 +68,19 @@ Keyboard convertSDLKeycode(SDL_KeyCode k) {
     case SDLK_LEFT: return K_LEFT;
     case SDLK_DOWN: return K_DOWN;
     case SDLK_RIGHT: return K_RIGHT;
+    case SDLK_F1: return K_F1;
+    case SDLK_F2: return K_F2;
+    case SDLK_F3: return K_F3;
+    case SDLK_F4: return K_F4;
+    case SDLK_F5: return K_F5;
+    case SDLK_F6: return K_F6;
+    case SDLK_F7: return K_F7;
+    case SDLK_F8: return K_F8;
+    case SDLK_F9: return K_F9;
+    case SDLK_F10: return K_F10;
+    case SDLK_F11: return K_F11;
+    case SDLK_F12: return K_F12;
+    case SDLK_ESCAPE: return K_ESCAPE;
     default: break;
   }
   return K_ESCAPE;
@@ -90,32 +97,43 @@ void io_init(void) {
     SDL_WINDOW_SHOWN
   );
   surface = SDL_GetWindowSurface(window);
+  io_configureBitmaps();
+}
+
+int io_handleEvent(SDL_Event* event, Keyboard* key) {
+  if (event->type == SDL_KEYDOWN) {
+    *key = convertSDLKeycode(event->key.keysym.sym);
+    return 1;
+  } else if (event->type == SDL_KEYUP) {
+    *key = convertSDLKeycode(event->key.keysym.sym);
+    return -1;
+  } else if (event->type == SDL_WINDOWEVENT && event->window.event == SDL_WINDOWEVENT_EXPOSED) {
+    // present the last frame again rather than redrawing it
+    SDL_UpdateWindowSurface(window);
+  }
 
-  OVERLAY_MSG = "";
-  PANIC_MSG = "";
-  PANIC_MODE = false;
-  BITMAP0 = malloc(sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height);
-  BITMAP1 = malloc(sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height);
-  BITMAP2 = malloc(sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height);
-  BITMAP3 = malloc(sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height);
+  if (event->type == SDL_QUIT) {
+    io_kill();
+    exit(0);
+  }
+
+  return 0;
 }
 
 int io_pollInput(Keyboard* key) {
   SDL_Event event;
   if (SDL_PollEvent(&event)) {
+    return io_handleEvent(&event, key);
+  }
 
-    if (event.type == SDL_KEYDOWN) {
-      *key = convertSDLKeycode(event.key.keysym.sym);
-      return 1;
-    } else if (event.type == SDL_KEYUP) {
-      *key = convertSDLKeycode(event.key.keysym.sym);
-      return -1;
-    }
+  return 0;
+}
 
-    if (event.type == SDL_QUIT) {
-      io_kill();
-      exit(0);
-    }
+int io_waitInput(Keyboard* key, int timeoutMs) {
+  // sleep until something happens instead of spinning
+  SDL_Event event;
+  if (SDL_WaitEventTimeout(&event, timeoutMs)) {
+    return io_handleEvent(&event, key);
   }
 
   return 0;
@@ -127,12 +145,9 @@ void io_render(void) {
   SDL_LockSurface(surface);
 
   if (PANIC_MODE) {
-    for (int i = 0; i < (CONFIG_DISPLAY.width * CONFIG_DISPLAY.height); i++) {
-      BITMAP0[i] = (rand() % 2) ? 0xFFFFFF : 0x000000;
-    }
-    io_drawString(PANIC_MSG, 0);
+    io_updateOverlay(PANIC_MSG, 0);
   } else {
-    io_drawString(OVERLAY_MSG, CONFIG_DEBUG.shouldDisplayDebugScreen ? 1 : 0);
+    io_updateOverlay(OVERLAY_MSG, CONFIG_DEBUG.shouldDisplayDebugScreen ? 1 : 0);
   }
 
   for (int i = 0; i < CONFIG_DISPLAY.screens; i++) {
@@ -143,116 +158,17 @@ void io_render(void) {
   SDL_UpdateWindowSurface(window);
 }
 
-void io_drawString(char* str, int screen) {
-  uint32_t* bmp;
-
-  if (screen == 0) {
-    bmp = BITMAP0;
-  } else if (screen == 1) {
-    bmp = BITMAP1;
-  } else if (screen == 2) {
-    bmp = BITMAP2;
-  } else if (screen == 3) {
-    bmp = BITMAP3;
-  }
-
-  int charPos = 0;  
-  int charsPerRow = CONFIG_DISPLAY.width / 8;
-  for (int i = 0; str[i] != '\0'; i++) {
-    if (str[i] == '\n') {
-      charPos = charPos - (charPos % charsPerRow) + charsPerRow;
-    } else if (str[i] == '\t') {
-      charPos += 1;
-    } else {
-      io_drawChar(str[i], charPos, bmp);
-      charPos += 1;
-    }
-  }
-}
-
-void io_drawChar(char chr, int charPos, uint32_t* bmp) {
-  int charsPerRow = CONFIG_DISPLAY.width / 8;
-  int startX = (charPos % charsPerRow) * 8;
-  int startY = (charPos / charsPerRow) * 8;
-
-  uint64_t charPix = font[chr & 127];
-  int8_t shift = 63;
-  for (int row = 0; row < 8; row++) {
-    for (int col = 0; col < 8; col++) {
-      int pos = ((startY + row) * CONFIG_DISPLAY.width) + startX + col;
-      bmp[pos] = ((charPix >> shift) & 1) ? 0xFFFFFF : 0x000000;
-      shift -= 1;
-    }
-  }
-}
-
-void io_drawScreen(int screen, uint32_t* pixels) {
-  uint32_t* bmp;
-
-  if (screen == 0) {
-    bmp = BITMAP0;
-  } else if (screen == 1) {
-    bmp = BITMAP1;
-  } else if (screen == 2) {
-    bmp = BITMAP2;
-  } else if (screen == 3) {
-    bmp = BITMAP3;
-  }
-
-  for (int x = 0; x < CONFIG_DISPLAY.width; x++) {
-    for (int y = 0; y < CONFIG_DISPLAY.height; y++) {
-      io_drawPixel(x, y, screen, bmp[(y * CONFIG_DISPLAY.width) + x], pixels);
-    }
-  }
-}
-
-void io_drawPixel(int x, int y, int screen, uint32_t color, uint32_t* pixels) {
-  // find starting x & y in screen
-  int screenX = (screen % 2 == 0) ? 0 : (CONFIG_DISPLAY.width * CONFIG_DISPLAY.scale);
-  int screenY = (screen < 2) ? 0 : (CONFIG_DISPLAY.height * CONFIG_DISPLAY.scale);
-  
-  int pixelsWidth = CONFIG_DISPLAY.width * CONFIG_DISPLAY.scale * (CONFIG_DISPLAY.screens == 1 ? 1 : 2);
-
-  // find starting x & y for pixel
-  int pixelX = screenX + (x * CONFIG_DISPLAY.scale);
-  int pixelY = screenY + (y * CONFIG_DISPLAY.scale);
-
-  for (int row = 0; row < CONFIG_DISPLAY.scale; row++) {
-    for (int col = 0; col < CONFIG_DISPLAY.scale; col++) {
-      pixels[((pixelY + row) * pixelsWidth) + pixelX + col] = color;
-    }
-  }
+void io_submitFrame(void) {
+  // frames are only presented through io_render
 }
 
 void io_kill(void) {
-  free(BITMAP0);
-  free(BITMAP1);
-  free(BITMAP2);
-  free(BITMAP3);
-}
-
-void io_clear(void) {
-  OVERLAY_MSG = "";
-  uint32_t* bmp;
-
-  for (int screen = 0; screen < CONFIG_DISPLAY.screens; screen++) {
-    if (screen == 0) {
-      bmp = BITMAP0;
-    } else if (screen == 1) {
-      bmp = BITMAP1;
-    } else if (screen == 2) {
-      bmp = BITMAP2;
-    } else if (screen == 3) {
-      bmp = BITMAP3;
-    }
-    for (int i = 0; i < (CONFIG_DISPLAY.width * CONFIG_DISPLAY.height); i += 1) {
-      bmp[i] = 0x000000;
-    }
-  }
-  io_render();
+  io_releaseBitmaps();
 }
 
 void io_panic(char* str) {
+  io_runPanicHandler();
+
   PANIC_MODE = true;
 
   char fullStr[1024];
@@ -261,10 +177,15 @@ void io_panic(char* str) {
   strcat(fullStr, str);
   PANIC_MSG = fullStr;
 
+  // the screen never changes again, so draw it once and wait to be closed
+  for (int i = 0; i < (CONFIG_DISPLAY.width * CONFIG_DISPLAY.height); i++) {
+    BITMAP0[i] = (rand() % 2) ? 0xFFFFFF : 0x000000;
+  }
+  io_render();
+
   while (true) {
     Keyboard key;
-    io_pollInput(&key);
-    io_render();
+    io_waitInput(&key, IO_WAIT_TIMEOUT_MS);
   }
 }
 #endif
@@ -35,6 +35,17 @@ int main(int argc, char* argv[]) {
 
   if (SUPPRESS_EXTIO || config_init(argv[1])) {
     io_init();
+#if (!SUPPRESS_EXTIO)
+    config_print();
+#endif
+    if (CONFIG_GOLDEN.listPath[0] != '\0') {
+      return golden_run(CONFIG_GOLDEN.listPath, CONFIG_GOLDEN.shouldUpdate);
+    }
+    if (CONFIG_CAPTURE.path[0] != '\0') {
+      if (!capture_init(CONFIG_CAPTURE.path, CONFIG_CAPTURE.format, CONFIG_DISPLAY.width, CONFIG_DISPLAY.height)) {
+        io_panic("Unable to start capture.");
+      }
+    }
     if (CONFIG_PLATFORM == EMU_PLAT_NES) {
       nes_init(SUPPRESS_EXTIO ? NULL : argv[2]);
     }
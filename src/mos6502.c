@@ -12,13 +12,14 @@ BytecodeProgram prgBytecode;
 
 void(*memWrite)(uint16_t, uint8_t);
 uint8_t(*memRead)(uint16_t);
+uint8_t(*memPeek)(uint16_t);
 
 CPUMnemonic mnemonicTable[0x100];
 CPUAddressingMode addrModeTable[0x100];
 uint8_t cycleTable[0x100];
 char* mnemonicStringTable[80];
 
-void mos6502_init(void(*w)(uint16_t, uint8_t), uint8_t(*r)(uint16_t)) {
+void mos6502_init(void(*w)(uint16_t, uint8_t), uint8_t(*r)(uint16_t), uint8_t(*p)(uint16_t)) {
   mos6502_configureTables();
 
   if (CONFIG_CPU.shouldCacheInstructions && !MINIMIZE_MEMORY) {
@@ -29,8 +30,7 @@ void mos6502_init(void(*w)(uint16_t, uint8_t), uint8_t(*r)(uint16_t)) {
 
   memWrite = w;
   memRead = r;
-  memWrite = w;
-  memRead = r;
+  memPeek = p;
 
   reg.a = 0x00;
   reg.x = 0x00;
@@ -40,88 +40,189 @@ void mos6502_init(void(*w)(uint16_t, uint8_t), uint8_t(*r)(uint16_t)) {
   reg.pc = 0x00;
 }
 
-void mos6502_step(char* traceStr, void(*c)(uint8_t)) {
+void mos6502_step(TraceRecord* record, void(*c)(uint8_t)) {
   Bytecode* bytecode = NULL;
+  Bytecode bc;
   if (CONFIG_CPU.shouldCacheInstructions && !MINIMIZE_MEMORY) {
     // ~20% performance savings observed w/ caching
     if (!prgBytecode.cacheMap[reg.pc]) {
-      static Bytecode bc;
-      bytecode = &bc;
-      mos6502_decode(bytecode, NULL, NULL, reg.pc);
-      prgBytecode.bytecodeCount += 1;
-      prgBytecode.bytecodes[prgBytecode.bytecodeCount - 1] = bc;
-      prgBytecode.addrMap[reg.pc] = prgBytecode.bytecodeCount - 1;
-      prgBytecode.cacheMap[reg.pc] = true;
+      mos6502_cacheInstruction(reg.pc);
     }
     bytecode = prgBytecode.bytecodes + prgBytecode.addrMap[reg.pc];
   } else {
-    Bytecode bc;
     bytecode = &bc;
-    char asmStr[33];
-    mos6502_decode(bytecode, asmStr, NULL, reg.pc);
-    if (traceStr != NULL) {
-      mos6502_generateTrace(traceStr, asmStr, bytecode);
-    }
+    mos6502_decode(bytecode, reg.pc);
+  }
+
+  // recorded from the bytecode either way, so tracing costs the same in both modes
+  if (record != NULL) {
+    mos6502_recordTrace(record, bytecode);
   }
 
   c(mos6502_execute(bytecode));
 }
 
-void mos6502_generateTrace(char* traceStr, char* asmStr, Bytecode* bytecode) {
+void mos6502_cacheInstruction(uint16_t pc) {
+  if (!CONFIG_CPU.shouldCacheInstructions || MINIMIZE_MEMORY || prgBytecode.cacheMap[pc]) return;
+
+  Bytecode bc;
+  mos6502_decode(&bc, pc);
+  prgBytecode.bytecodeCount += 1;
+  prgBytecode.bytecodes[prgBytecode.bytecodeCount - 1] = bc;
+  prgBytecode.addrMap[pc] = prgBytecode.bytecodeCount - 1;
+  prgBytecode.cacheMap[pc] = true;
+}
+
+uint8_t mos6502_instructionLength(uint8_t opcode) {
+  return mos6502_byteCount(addrModeTable[opcode]);
+}
+
+void mos6502_recordTrace(TraceRecord* record, Bytecode* bytecode) {
+  // only what the text trace shows is kept, cycles are left to the caller
+  record->pc = reg.pc;
+  record->a = reg.a;
+  record->x = reg.x;
+  record->y = reg.y;
+  record->p = reg.p;
+  record->s = reg.s;
+  record->addr = 0;
+  record->pointer = 0;
+  record->value = 0;
+  record->flags = 0;
+  for (int i = 0; i < 3; i++) {
+    record->data[i] = (i < bytecode->count) ? bytecode->data[i] : 0;
+  }
+
+  // peeked rather than read, so tracing can't change what it traces
+  bool isJump = bytecode->mnemonic == I_JMP || bytecode->mnemonic == I_JSR;
+  switch (bytecode->addressingMode) {
+    case AM_ZERO_PAGE:
+      record->addr = mos6502_fetchValue(bytecode);
+      record->value = memPeek(record->addr);
+      break;
+    case AM_ABSOLUTE:
+    case AM_ABS_X:
+    case AM_ABS_Y:
+    case AM_ZP_X:
+    case AM_ZP_Y:
+      if (!isJump) {
+        record->addr = mos6502_fetchValue(bytecode);
+        record->value = memPeek(record->addr);
+      }
+      break;
+    case AM_ZP_X_INDIRECT: {
+      uint8_t addr = bytecode->data[1] + reg.x;
+      uint8_t addrInc = addr + 1;
+      record->addr = ((uint16_t)memPeek(addrInc) << 8) | (uint16_t)memPeek(addr);
+      record->value = memPeek(record->addr);
+      break;
+    }
+    case AM_ABS_INDIRECT: {
+      uint16_t addr = ((uint16_t)bytecode->data[2] << 8) | (uint16_t)bytecode->data[1];
+      uint16_t high = ((addr & 0x00FF) == 0xFF) ? memPeek(addr & 0xFF00) : memPeek(addr + 1);
+      record->addr = (high << 8) | memPeek(addr);
+      break;
+    }
+    case AM_ZP_INDIRECT_Y: {
+      uint8_t addr = bytecode->data[1];
+      uint8_t addrInc = addr + 1;
+      record->pointer = ((uint16_t)memPeek(addrInc) << 8) | (uint16_t)memPeek(addr);
+      record->addr = record->pointer + reg.y;
+      record->value = memPeek(record->addr);
+      break;
+    }
+    default: break;
+  }
+}
+
+void mos6502_formatRecord(TraceRecord* record, char* traceStr) {
 #if (!SUPPRESS_EXTIO)
+  CPUAddressingMode addrMode = addrModeTable[record->data[0]];
+  CPUMnemonic mnemonic = mnemonicTable[record->data[0]];
+  bool isJump = mnemonic == I_JMP || mnemonic == I_JSR;
+  char asmStr[128];
+  char operandStr[64];
   char dataStr[9];
   char operandConvertStr[32];
   operandConvertStr[0] = '\0';
 
-  if (bytecode->count == 1) {
+  if (record->flags & TRACE_FLAG_EVENT) {
+    char* eventStr = (record->flags & TRACE_FLAG_NMI) ? "NMI"
+      : ((record->flags & TRACE_FLAG_IRQ) ? "IRQ" : "RESET");
+    sprintf(asmStr, "--- %s ---", eventStr);
+    sprintf(traceStr, "%04X  %-8s %-32s A:%02X X:%02X Y:%02X P:%02X SP:%02X",
+      record->pc, "", asmStr, record->a, record->x, record->y, record->p, record->s);
+    return;
+  }
+
+  uint8_t count = mos6502_byteCount(addrMode);
+  if (count == 1) {
     sprintf(dataStr, "%02X",
-      bytecode->data[0]);
-  } else if (bytecode->count == 2) {
+      record->data[0]);
+  } else if (count == 2) {
     sprintf(dataStr, "%02X %02X",
-      bytecode->data[0], bytecode->data[1]);
-  } else if (bytecode->count == 3) {
+      record->data[0], record->data[1]);
+  } else {
     sprintf(dataStr, "%02X %02X %02X",
-      bytecode->data[0], bytecode->data[1], bytecode->data[2]);
+      record->data[0], record->data[1], record->data[2]);
   }
 
-  if (bytecode->addressingMode == AM_ZERO_PAGE) {
-    sprintf(operandConvertStr, " = %02X", memRead(mos6502_fetchValue(bytecode)));
-  } else if (bytecode->addressingMode == AM_ABSOLUTE) {
-    if (bytecode->mnemonic != I_JMP && bytecode->mnemonic != I_JSR) {
-      sprintf(operandConvertStr, " = %02X", memRead(mos6502_fetchValue(bytecode)));
-    }
-  } else if (bytecode->addressingMode == AM_ABS_X || bytecode->addressingMode == AM_ABS_Y) {
-    if (bytecode->mnemonic != I_JMP && bytecode->mnemonic != I_JSR) {
-      sprintf(operandConvertStr, " @ %04X = %02X", mos6502_fetchValue(bytecode), memRead(mos6502_fetchValue(bytecode)));
-    }
-  } else if (bytecode->addressingMode == AM_ZP_X || bytecode->addressingMode == AM_ZP_Y) {
-    if (bytecode->mnemonic != I_JMP && bytecode->mnemonic != I_JSR) {
-      sprintf(operandConvertStr, " @ %02X = %02X", mos6502_fetchValue(bytecode), memRead(mos6502_fetchValue(bytecode)));
-    }
-  } else if (bytecode->addressingMode == AM_ABS_INDIRECT) {
-    sprintf(operandConvertStr, " = %04X", mos6502_fetchValue(bytecode));
-  } else if (bytecode->addressingMode == AM_ZP_X_INDIRECT) {
-    if (bytecode->mnemonic != I_JMP && bytecode->mnemonic != I_JSR) {
+  if (record->flags & TRACE_FLAG_NO_OPERAND) {
+    // operand values weren't read when recorded
+  } else if (addrMode == AM_ZERO_PAGE) {
+    sprintf(operandConvertStr, " = %02X", record->value);
+  } else if (addrMode == AM_ABSOLUTE) {
+    if (!isJump) {
+      sprintf(operandConvertStr, " = %02X", record->value);
+    }
+  } else if (addrMode == AM_ABS_X || addrMode == AM_ABS_Y) {
+    if (!isJump) {
+      sprintf(operandConvertStr, " @ %04X = %02X", record->addr, record->value);
+    }
+  } else if (addrMode == AM_ZP_X || addrMode == AM_ZP_Y) {
+    if (!isJump) {
+      sprintf(operandConvertStr, " @ %02X = %02X", record->addr, record->value);
+    }
+  } else if (addrMode == AM_ABS_INDIRECT) {
+    sprintf(operandConvertStr, " = %04X", record->addr);
+  } else if (addrMode == AM_ZP_X_INDIRECT) {
+    if (!isJump) {
       sprintf(operandConvertStr, " @ %02X = %04X = %02X",
-        (uint8_t)(bytecode->data[1] + reg.x),
-        mos6502_fetchValue(bytecode),
-        memRead(mos6502_fetchValue(bytecode)));
+        (uint8_t)(record->data[1] + record->x), record->addr, record->value);
     }
-  } else if (bytecode->addressingMode == AM_ZP_INDIRECT_Y) {
-    if (bytecode->mnemonic != I_JMP && bytecode->mnemonic != I_JSR) {
-      uint8_t addr = bytecode->data[1];
-      uint8_t addrInc = addr + 1;
-      uint16_t indaddr = ((uint16_t)memRead(addrInc) << 8) | (uint16_t)memRead(addr);
+  } else if (addrMode == AM_ZP_INDIRECT_Y) {
+    if (!isJump) {
       sprintf(operandConvertStr, " = %04X @ %04X = %02X",
-        indaddr,
-        mos6502_fetchValue(bytecode),
-        memRead(mos6502_fetchValue(bytecode)));
+        record->pointer, record->addr, record->value);
     }
   }
 
-  strcat(asmStr, operandConvertStr);
+  mos6502_formatOperand(operandStr, addrMode, record->data, record->pc);
+  sprintf(asmStr, "%*s %s%s", 4, mnemonicStringTable[mnemonic], operandStr, operandConvertStr);
   sprintf(traceStr, "%04X  %-8s %-32s A:%02X X:%02X Y:%02X P:%02X SP:%02X",
-    reg.pc, dataStr, asmStr, reg.a, reg.x, reg.y, reg.p, reg.s);
+    record->pc, dataStr, asmStr, record->a, record->x, record->y, record->p, record->s);
+#endif
+}
+
+void mos6502_formatOperand(char* operandStr, CPUAddressingMode addrMode, uint8_t* data, uint16_t pc) {
+#if (!SUPPRESS_EXTIO)
+  switch (addrMode) {
+    case AM_UNSET: operandStr[0] = '\0'; break;
+    case AM_ACCUMULATOR: sprintf(operandStr, "A"); break;
+    case AM_IMPLIED: operandStr[0] = '\0'; break;
+    case AM_IMMEDIATE: sprintf(operandStr, "#$%02X", data[1]); break;
+    case AM_ABSOLUTE: sprintf(operandStr, "$%02X%02X", data[2], data[1]);  break;
+    case AM_ZERO_PAGE: sprintf(operandStr, "$%02X", data[1]); break;
+    case AM_RELATIVE: sprintf(operandStr, "$%02X", (pc + 2) + (int8_t)data[1]); break;
+    case AM_ABS_INDIRECT: sprintf(operandStr, "($%02X%02X)", data[2], data[1]); break;
+    case AM_ABS_X: sprintf(operandStr, "$%02X%02X,X", data[2], data[1]); break;
+    case AM_ABS_Y: sprintf(operandStr, "$%02X%02X,Y", data[2], data[1]); break;
+    case AM_ZP_X: sprintf(operandStr, "$%02X,X", data[1]); break;
+    case AM_ZP_Y: sprintf(operandStr, "$%02X,Y", data[1]); break;
+    case AM_ZP_INDIRECT_Y: sprintf(operandStr, "($%02X),Y", data[1]); break;
+    case AM_ZP_X_INDIRECT: sprintf(operandStr, "($%02X,X)", data[1]); break;
+    default: operandStr[0] = '\0'; break;
+  }
 #endif
 }
 
@@ -254,73 +355,54 @@ force_inline uint16_t mos6502_fetchValue(Bytecode* bytecode) {
   return 0;
 }
 
-void mos6502_decode_external_wrapper(Bytecode* bytecode, char* assemblyResult, uint8_t* byteCount, uint16_t pc) {
-  mos6502_decode(bytecode, assemblyResult, byteCount, pc);
+char* mos6502_mnemonicName(uint8_t opcode) {
+  return mnemonicStringTable[mnemonicTable[opcode]];
 }
 
-force_inline void mos6502_decode(Bytecode* bytecode, char* assemblyResult, uint8_t* byteCount, uint16_t pc) {
-  uint8_t opcode = memRead(pc);
-  CPUAddressingMode addrMode = addrModeTable[opcode];
-  CPUMnemonic mnemonic = mnemonicTable[opcode];
-  uint8_t bytes = 0;
+void mos6502_decode_external_wrapper(Bytecode* bytecode, uint16_t pc) {
+  mos6502_decode(bytecode, pc);
+}
 
-  switch (addrMode) {
-    case AM_UNSET: bytes = 1; break;
-    case AM_ACCUMULATOR: bytes = 1; break;
-    case AM_IMPLIED: bytes = 1; break;
-    case AM_IMMEDIATE: bytes = 2; break;
-    case AM_ABSOLUTE: bytes = 3; break;
-    case AM_ZERO_PAGE: bytes = 2; break;
-    case AM_RELATIVE: bytes = 2; break;
-    case AM_ABS_INDIRECT: bytes = 3; break;
-    case AM_ABS_X: bytes = 3; break;
-    case AM_ABS_Y: bytes = 3; break;
-    case AM_ZP_X: bytes = 2; break;
-    case AM_ZP_Y: bytes = 2; break;
-    case AM_ZP_INDIRECT_Y: bytes = 2; break;
-    case AM_ZP_X_INDIRECT: bytes = 2; break;
-    default: bytes = 1; break;
-  }
+void mos6502_formatBytecode(Bytecode* bytecode, uint16_t pc, char* assemblyStr) {
+#if (!SUPPRESS_EXTIO)
+  char operandStr[64];
+  mos6502_formatOperand(operandStr, bytecode->addressingMode, bytecode->data, pc);
+  sprintf(assemblyStr, "%*s %s", 4, mnemonicStringTable[bytecode->mnemonic], operandStr);
+#endif
+}
 
-  if (bytecode != NULL) {
-    bytecode->addressingMode = addrMode;
-    bytecode->mnemonic = mnemonic;
-    bytecode->count = bytes;
-    bytecode->data[0] = opcode;
-    for (int i = 1; i < bytes; i++) {
-      bytecode->data[i] = memRead(pc + i);
-    }
-  }
+force_inline void mos6502_decode(Bytecode* bytecode, uint16_t pc) {
+  uint8_t opcode = memRead(pc);
+  CPUAddressingMode addrMode = addrModeTable[opcode];
+  uint8_t bytes = mos6502_byteCount(addrMode);
 
-  if (byteCount != NULL) {
-    *byteCount = bytes;
+  bytecode->addressingMode = addrMode;
+  bytecode->mnemonic = mnemonicTable[opcode];
+  bytecode->count = bytes;
+  bytecode->data[0] = opcode;
+  for (int i = 1; i < bytes; i++) {
+    bytecode->data[i] = memRead(pc + i);
   }
+}
 
-#if (!SUPPRESS_EXTIO)
-  if (assemblyResult != NULL && CONFIG_DEBUG.shouldTraceInstructions) {
-    char operandString[64];
-
-    switch (addrMode) {
-      case AM_UNSET: sprintf(operandString, ""); break;
-      case AM_ACCUMULATOR: sprintf(operandString, "A"); break;
-      case AM_IMPLIED: sprintf(operandString, ""); break;
-      case AM_IMMEDIATE: sprintf(operandString, "#$%02X", memRead(pc + 1)); break;
-      case AM_ABSOLUTE: sprintf(operandString, "$%02X%02X", memRead(pc + 2), memRead(pc + 1));  break;
-      case AM_ZERO_PAGE: sprintf(operandString, "$%02X", memRead(pc + 1)); break;
-      case AM_RELATIVE: sprintf(operandString, "$%02X", (pc + 2) + (int8_t)memRead(pc + 1)); break;
-      case AM_ABS_INDIRECT: sprintf(operandString, "($%02X%02X)", memRead(pc + 2), memRead(pc + 1)); break;
-      case AM_ABS_X: sprintf(operandString, "$%02X%02X,X", memRead(pc + 2), memRead(pc + 1)); break;
-      case AM_ABS_Y: sprintf(operandString, "$%02X%02X,Y", memRead(pc + 2), memRead(pc + 1)); break;
-      case AM_ZP_X: sprintf(operandString, "$%02X,X", memRead(pc + 1)); break;
-      case AM_ZP_Y: sprintf(operandString, "$%02X,Y", memRead(pc + 1)); break;
-      case AM_ZP_INDIRECT_Y: sprintf(operandString, "($%02X),Y", memRead(pc + 1)); break;
-      case AM_ZP_X_INDIRECT: sprintf(operandString, "($%02X,X)", memRead(pc + 1)); break;
-      default: sprintf(operandString, ""); break;
-    }
-
-    sprintf(assemblyResult, "%*s %s", 4, mnemonicStringTable[mnemonic], operandString);
+force_inline uint8_t mos6502_byteCount(CPUAddressingMode addrMode) {
+  switch (addrMode) {
+    case AM_UNSET: return 1;
+    case AM_ACCUMULATOR: return 1;
+    case AM_IMPLIED: return 1;
+    case AM_IMMEDIATE: return 2;
+    case AM_ABSOLUTE: return 3;
+    case AM_ZERO_PAGE: return 2;
+    case AM_RELATIVE: return 2;
+    case AM_ABS_INDIRECT: return 3;
+    case AM_ABS_X: return 3;
+    case AM_ABS_Y: return 3;
+    case AM_ZP_X: return 2;
+    case AM_ZP_Y: return 2;
+    case AM_ZP_INDIRECT_Y: return 2;
+    case AM_ZP_X_INDIRECT: return 2;
+    default: return 1;
   }
-#endif
 }
 
 force_inline uint8_t mos6502_execute(Bytecode* bytecode) {
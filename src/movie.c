@@ -0,0 +1,192 @@
+/**
+ * movie.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/movie.h"
+
+#if (SUPPRESS_EXTIO)
+
+bool movie_startRecording(char* path, uint64_t romHash) {
+  return false;
+}
+
+bool movie_startReplay(char* path) {
+  return false;
+}
+
+bool movie_recordFrame(uint32_t frame, uint8_t input) {
+  return true;
+}
+
+bool movie_replayFrame(uint32_t frame, uint8_t* input) {
+  return false;
+}
+
+void movie_finish(void) {}
+
+bool movie_isRecording(void) {
+  return false;
+}
+
+bool movie_isReplaying(void) {
+  return false;
+}
+
+uint64_t movie_romHash(void) {
+  return 0;
+}
+
+bool movie_hasInputBefore(uint32_t frame) {
+  return false;
+}
+
+#else
+
+MovieHeader movieHeader;
+uint8_t* movieInputs = NULL;
+uint32_t movieCapacity = 0;
+char moviePath[FILEIO_MAX_PATH_SIZE];
+bool movieRecording = false;
+bool movieReplaying = false;
+
+bool movie_startRecording(char* path, uint64_t romHash) {
+  strncpy(moviePath, path, FILEIO_MAX_PATH_SIZE - 1);
+  moviePath[FILEIO_MAX_PATH_SIZE - 1] = '\0';
+
+  // make sure the movie can be written before anything is recorded
+  FILE* fp = fopen(moviePath, "wb");
+  if (fp == NULL) return false;
+  fclose(fp);
+
+  movieHeader.magic = MOVIE_MAGIC;
+  movieHeader.version = MOVIE_VERSION;
+  movieHeader.romHash = romHash;
+  movieHeader.frames = 0;
+  movieHeader.reserved = 0;
+
+  movieCapacity = 60 * 60;
+  movieInputs = malloc(movieCapacity);
+  if (movieInputs == NULL) return false;
+
+  movieRecording = true;
+  atexit(&movie_finish);
+  return true;
+}
+
+bool movie_startReplay(char* path) {
+  uint8_t* data;
+  int size = fileio_readFileAsBinary(path, &data);
+  if (size == -1) return false;
+
+  if (size < sizeof(MovieHeader)) {
+    free(data);
+    return false;
+  }
+
+  memcpy(&movieHeader, data, sizeof(MovieHeader));
+  if (movieHeader.magic != MOVIE_MAGIC || movieHeader.version != MOVIE_VERSION
+      || size - sizeof(MovieHeader) < movieHeader.frames) {
+    free(data);
+    return false;
+  }
+
+  movieInputs = malloc(movieHeader.frames + 1);
+  if (movieInputs == NULL) {
+    free(data);
+    return false;
+  }
+  memcpy(movieInputs, data + sizeof(MovieHeader), movieHeader.frames);
+  free(data);
+
+  movieReplaying = true;
+  return true;
+}
+
+bool movie_write(void) {
+  // replaced in one step, so a kill mid-write leaves the previous movie intact
+  char tempPath[FILEIO_MAX_PATH_SIZE + 4];
+  sprintf(tempPath, "%s.tmp", moviePath);
+  FILE* fp = fopen(tempPath, "wb");
+  if (fp == NULL) return false;
+  bool didWrite = fwrite(&movieHeader, sizeof(MovieHeader), 1, fp) == 1
+    && fwrite(movieInputs, 1, movieHeader.frames, fp) == movieHeader.frames;
+  didWrite &= (fclose(fp) == 0);
+  return didWrite && rename(tempPath, moviePath) == 0;
+}
+
+bool movie_recordFrame(uint32_t frame, uint8_t input) {
+  if (!movieRecording) return true;
+
+  if (frame >= movieCapacity) {
+    uint32_t capacity = movieCapacity;
+    while (frame >= capacity) {
+      capacity *= 2;
+    }
+    uint8_t* inputs = realloc(movieInputs, capacity);
+    if (inputs == NULL) return false;
+    movieInputs = inputs;
+    movieCapacity = capacity;
+  }
+
+  // frames before this one must already be in the movie
+  if (frame > movieHeader.frames) {
+    memset(movieInputs + movieHeader.frames, 0, frame - movieHeader.frames);
+  }
+
+  movieInputs[frame] = input;
+  movieHeader.frames = frame + 1;
+
+  if (movieHeader.frames % MOVIE_FLUSH_FRAMES == 0 && !movie_write()) {
+    fprintf(stderr, "MOVIE: unable to write %s\n", moviePath);
+  }
+  return true;
+}
+
+bool movie_replayFrame(uint32_t frame, uint8_t* input) {
+  if (!movieReplaying) return false;
+
+  if (frame >= movieHeader.frames) {
+    // hand control back to live input
+    movieReplaying = false;
+    fprintf(stderr, "MOVIE: replay finished after %u frames\n", movieHeader.frames);
+    return false;
+  }
+
+  *input = movieInputs[frame];
+  return true;
+}
+
+void movie_finish(void) {
+  if (!movieRecording) return;
+  movieRecording = false;
+
+  if (!movie_write()) {
+    fprintf(stderr, "MOVIE: unable to write %s\n", moviePath);
+  }
+  fprintf(stderr, "MOVIE: %u frames recorded\n", movieHeader.frames);
+}
+
+bool movie_isRecording(void) {
+  return movieRecording;
+}
+
+bool movie_isReplaying(void) {
+  return movieReplaying;
+}
+
+uint64_t movie_romHash(void) {
+  return movieHeader.romHash;
+}
+
+bool movie_hasInputBefore(uint32_t frame) {
+  if (!movieReplaying) return false;
+  for (uint32_t i = 0; i < frame && i < movieHeader.frames; i++) {
+    if (movieInputs[i] != 0) return true;
+  }
+  return false;
+}
+
+#endif
@@ -12,6 +12,15 @@ uint8_t memoryMap[65536];
 int32_t cpuCycles = 0;
 uint32_t realFreq = 0;
 bool resetPPUStat = false;
+uint32_t frameCount = 0;
+bool isRewinding = false;
+bool isFastForwarding = false;
+bool isRunningAhead = false;
+NESState frameState;
+NESState runAheadState;
+NESIdleLoop idleLoop;
+bool isIdleSafe = false;
+uint64_t frameCycleBase = 0;
 
 struct timeval t1, t2;
 
@@ -20,21 +29,52 @@ void nes_init(char* fsRoot) {
   
   nes_configureMemory();
   nesppu_init(&cartridge);
-  mos6502_init(&nes_cpuWrite, &nes_cpuRead);
+  mos6502_init(&nes_cpuWrite, &nes_cpuRead, &nes_cpuPeek);
+
+  if (!cdl_load(cartridge.romHash, cartridge.header.prgRomSize * 0x4000, cartridge.header.chrRomSize * 0x2000)) {
+    io_panic("Unable to allocate code/data log.");
+  }
 
   if (cartridge.header.disassemblyMode) {
     nes_disassemble("./debug/dasm.s");
     OVERLAY_MSG = "Dissasembly successful.";
+    io_render();
     while (true) {
       Keyboard key;
-      io_pollInput(&key);
-      io_render();
+      io_waitInput(&key, IO_WAIT_TIMEOUT_MS);
     }
   } else if (CONFIG_DEBUG.shouldDebugCPU) {
     nes_debugCPU();
   } else {
     if (CONFIG_DEBUG.shouldTraceInstructions) {
-      fileio_writeStringToFile("./debug/trace.log", "", false);
+      char* path = (CONFIG_DEBUG.traceFormat == TRACE_BINARY) ? TRACELOG_BINARY_PATH : TRACELOG_TEXT_PATH;
+      if (!tracelog_open(path, CONFIG_DEBUG.traceFormat)) {
+        io_panic("Unable to write trace.");
+      }
+    }
+    if (CONFIG_DEBUG.shouldRecordFlight) {
+      if (!flight_init()) {
+        io_panic("Unable to allocate flight recorder.");
+      }
+      io_onPanic(&nes_dumpFlight);
+    }
+    if (CONFIG_DEBUG.shouldProfile && !profile_init()) {
+      io_panic("Unable to allocate profiler.");
+    }
+    if (CONFIG_DEBUG.shouldCountHostEvents) {
+      // the emulator runs as usual without them
+      perfcount_init();
+    }
+    if (cdl_isLoaded()) {
+      // PRG is fixed with mapper 0, so anything executed last time is safe to decode now
+      for (uint32_t addr = 0x8000; addr <= 0xFFFF; addr++) {
+        if (cdl_flags(addr) & CDL_OPCODE) {
+          mos6502_cacheInstruction(addr);
+        }
+      }
+    }
+    if (CONFIG_DEBUG.shouldLogCodeData && !cdl_startLogging()) {
+      io_panic("Unable to allocate code/data log.");
     }
     nes_start();
   }
@@ -44,34 +84,74 @@ void nes_init(char* fsRoot) {
 
 void nes_start(void) {
   mos6502_interrupt_reset();
+  if (flight_isActive()) {
+    nes_recordFlight(TRACE_FLAG_RESET);
+  }
   cpuCycles += 4;
   uint32_t elapsed = 0;
   uint32_t cyclesPerInterval = CONFIG_CPU.frequency / INTERVALS_PER_SEC;
   int32_t realUs = 0;
   uint32_t intervals = 0;
-  char outputStr[512];
+  char outputStr[1024];
+
+  if (CONFIG_SHM.name[0] != '\0' && !nesshm_init(CONFIG_SHM.name)) {
+    io_panic("Unable to open shared memory.");
+  }
+
+  if (CONFIG_MOVIE.recordPath[0] != '\0' && !movie_startRecording(CONFIG_MOVIE.recordPath, cartridge.romHash)) {
+    io_panic("Unable to record movie.");
+  }
 
+  if (CONFIG_MOVIE.replayPath[0] != '\0') {
+    if (!movie_startReplay(CONFIG_MOVIE.replayPath)) {
+      io_panic("Unable to read movie.");
+    } else if (movie_romHash() != cartridge.romHash) {
+      io_panic("Movie was recorded with a different ROM.");
+    } else if (CONFIG_BOOT.cacheFrames > 0 && movie_hasInputBefore(CONFIG_BOOT.cacheFrames)) {
+      // boot frames run without the movie, so that input would be dropped
+      io_panic("Movie has input before BOOT_cacheFrames.");
+    }
+  }
+
+  if (CONFIG_HASH.logPath[0] != '\0' && !hash_startLog(CONFIG_HASH.logPath, cartridge.romHash)) {
+    io_panic("Unable to write hash log.");
+  }
+
+  if (CONFIG_HASH.comparePath[0] != '\0') {
+    if (!hash_loadReference(CONFIG_HASH.comparePath)) {
+      io_panic("Unable to read hash log.");
+    } else if (hash_referenceRomHash() != cartridge.romHash) {
+      io_panic("Hash log was recorded with a different ROM.");
+    }
+  }
+
+  if (CONFIG_TIMELINE.path[0] != '\0' && !timeline_open(CONFIG_TIMELINE.path, CONFIG_CPU.frequency, &nes_cycleCount)) {
+    io_panic("Unable to write timeline.");
+  }
+
+  if (CONFIG_REWIND.bufferSize > 0 && !rewind_init(sizeof(NESState), CONFIG_REWIND.bufferSize * 1024)) {
+    io_panic("Unable to allocate rewind buffer.");
+  }
+
+  if (CONFIG_BOOT.cacheFrames > 0) {
+    nes_boot(cyclesPerInterval);
+  }
+
+  #if (TIMER_ACTIVE)
+    timer_init();
+  #endif
   #if (!SUPPRESS_TIMING)
     gettimeofday(&t1, 0);
   #endif
   while (true) {
-    // perform desired number of cpu cycles per ms
-    while (cpuCycles < cyclesPerInterval) {
-      if (CONFIG_DEBUG.shouldTraceInstructions) {
-        if (CONFIG_CPU.shouldCacheInstructions) {
-          io_panic("Cannot trace with caching.");
-        }
-        char trace[256];
-        trace[0] = '\0';
-        mos6502_step(trace, &nes_finishedInstruction);
-        #if (!SUPPRESS_EXTIO)
-          sprintf(trace, "%s\n", trace);
-          fileio_writeStringToFile("./debug/trace.log", trace, true);
-        #endif
-      } else {
-        mos6502_step(NULL, &nes_finishedInstruction);
-      }
+    // fast-forward runs several frames per interval but only shows the last
+    int frames = (isFastForwarding && !isRewinding) ? CONFIG_FASTFORWARD.multiplier : 1;
+    for (int i = 1; i < frames; i++) {
+      nes_emulateFrame(cyclesPerInterval, false);
+      realFreq += cpuCycles;
+      cpuCycles -= cyclesPerInterval;
     }
+    nes_emulateFrame(cyclesPerInterval, true);
 
     // update metrics every second
     if (intervals == INTERVALS_PER_SEC / PERFORMANCE_UPDATES_PER_SEC) {
@@ -80,24 +160,41 @@ void nes_start(void) {
       intervals = 0;
     }
 
+    framegraph_mark(FRAMEGRAPH_EMULATION);
+
     // perform I/O updates every interval
     if (realUs > TIMING_INTERVAL) {
       Keyboard key;
+      TIMER_BEGIN(TIMER_INPUT);
+      timeline_begin("input", TIMELINE_TID_MAIN, false);
       int status = io_pollInput(&key);
       nes_toggleJoypad(key, status);
+      timeline_end("input", TIMELINE_TID_MAIN, false);
+      TIMER_END(TIMER_INPUT);
+      TIMER_BEGIN(TIMER_RENDER);
+      timeline_begin("present", TIMELINE_TID_MAIN, false);
       io_render();
+      timeline_end("present", TIMELINE_TID_MAIN, false);
+      TIMER_END(TIMER_RENDER);
       realUs -= TIMING_INTERVAL;
       intervals += 1;
     }
+    framegraph_mark(FRAMEGRAPH_RENDER);
 
     #if (!SUPPRESS_TIMING)
       // delay if necessary
       gettimeofday(&t2, 0);
       elapsed = ((t2.tv_sec - t1.tv_sec) * 1000000) + t2.tv_usec - t1.tv_usec;
       if (CONFIG_DEBUG.shouldLimitFrequency) {
+        TIMER_BEGIN(TIMER_SLEEP);
+        timeline_begin("sleep", TIMELINE_TID_MAIN, false);
         usleep(elapsed < TIMING_INTERVAL ? usleep(TIMING_INTERVAL - elapsed) : 0);
+        timeline_end("sleep", TIMELINE_TID_MAIN, false);
+        TIMER_END(TIMER_SLEEP);
       }
     #endif
+    framegraph_mark(FRAMEGRAPH_SLEEP);
+    framegraph_endFrame();
 
     // perform time-related calculations
     #if (!SUPPRESS_TIMING)
@@ -110,12 +207,275 @@ void nes_start(void) {
     #endif
     realFreq += cpuCycles;
     cpuCycles -= cyclesPerInterval;
+    #if (TIMER_ACTIVE)
+      timer_endFrame();
+    #endif
     #if (!SUPPRESS_TIMING)
       gettimeofday(&t1, 0);
     #endif
   }
 }
 
+void nes_emulateFrame(uint32_t cyclesPerInterval, bool isShown) {
+  // emulated time runs backwards while rewinding, so only host time is kept
+  bool isEmulatedFrame = !isRewinding;
+  timeline_begin("frame", TIMELINE_TID_MAIN, isEmulatedFrame);
+
+  // hashes cover the frame, so keep drawing while they are being checked
+  bool shouldDraw = isShown || hash_isActive();
+
+  // with run-ahead, only the predicted frame is ever shown
+  nesppu_setRenderSkip(!shouldDraw || (CONFIG_RUNAHEAD.frames > 0 && !isRewinding));
+
+  if (isRewinding) {
+    // stay on the oldest frame once the history runs out
+    if (!nes_rewindFrame()) {
+      cpuCycles += cyclesPerInterval;
+    }
+  }
+
+  // input only changes between frames, so a movie is one byte per frame
+  if (!isRewinding) {
+    uint8_t buttons;
+    if (movie_replayFrame(frameCount, &buttons)) {
+      nesjoypad_setState(buttons);
+    } else if (!movie_recordFrame(frameCount, nesjoypad_getState())) {
+      io_panic("Unable to record movie.");
+    }
+  }
+
+  nes_runFrame(cyclesPerInterval, CONFIG_DEBUG.shouldTraceInstructions);
+
+  if (hash_isActive() && !isRewinding) {
+    nes_checkFrameHash();
+  }
+
+  if (rewind_isActive() && !isRewinding) {
+    nes_saveState(&frameState);
+    rewind_push((uint8_t*) &frameState);
+  }
+
+  if (isShown) {
+    if (CONFIG_RUNAHEAD.frames > 0 && !isRewinding) {
+      nes_runAhead(cyclesPerInterval);
+    }
+
+    if (isHeatmapActive) {
+      heatmap_draw(BITMAP1);
+    }
+    if (CONFIG_DEBUG.shouldDisplayDebugScreen) {
+      framegraph_draw();
+    }
+
+    framegraph_mark(FRAMEGRAPH_EMULATION);
+    timeline_begin("present", TIMELINE_TID_MAIN, false);
+    capture_submitFrame(BITMAP0);
+    nesshm_publishFrame(frameCount, memoryMap, BITMAP0);
+    TIMER_BEGIN(TIMER_RENDER);
+    io_submitFrame();
+    TIMER_END(TIMER_RENDER);
+    timeline_end("present", TIMELINE_TID_MAIN, false);
+    framegraph_mark(FRAMEGRAPH_RENDER);
+  }
+  timeline_end("frame", TIMELINE_TID_MAIN, isEmulatedFrame);
+  frameCount += 1;
+
+  // external input takes effect from the start of the next frame
+  nesshm_applyInput();
+}
+
+void nes_boot(uint32_t cyclesPerInterval) {
+  // anything that changes the machine after boot must be part of the key
+  struct {
+    uint32_t frequency;
+    uint32_t frames;
+    uint32_t stateSize;
+  } key = { CONFIG_CPU.frequency, CONFIG_BOOT.cacheFrames, sizeof(NESState) };
+  char path[64];
+  sprintf(path, NES_BOOTCACHE_PATH, (unsigned long long) cartridge.romHash,
+    (unsigned long long) hash_compute((uint8_t*) &key, sizeof(key), NES_STATE_VERSION));
+
+  if (nes_loadStateFromFile(path)) return;
+
+  // boot frames are never shown, so both paths start from a blank screen
+  nesppu_setRenderSkip(true);
+  while (frameCount < CONFIG_BOOT.cacheFrames) {
+    nes_runFrame(cyclesPerInterval, false);
+    cpuCycles -= cyclesPerInterval;
+    frameCount += 1;
+  }
+
+  #if (!SUPPRESS_EXTIO && !SUPPRESS_TIMING)
+    // written aside and moved into place, so concurrent runs never load half a state
+    char tempPath[80];
+    sprintf(tempPath, "%s.%d", path, (int) getpid());
+    if (!nes_saveStateToFile(tempPath) || rename(tempPath, path) != 0) {
+      // the boot itself succeeded, it just has to run again next time
+      remove(tempPath);
+      fprintf(stderr, "BOOT: unable to write %s\n", path);
+    }
+  #endif
+}
+
+void nes_runFrame(uint32_t cyclesPerInterval, bool shouldTrace) {
+  // cycle counts from the last frame don't carry over
+  isIdleSafe = false;
+  frameCycleBase = (uint64_t) frameCount * cyclesPerInterval;
+
+  // run-ahead is thrown away and rewound frames run nothing, so neither is
+  // counted as a frame
+  bool isRealFrame = !isRunningAhead && !isRewinding;
+  bool shouldRecordFlight = flight_isActive() && !isRunningAhead;
+  bool shouldProfile = profile_isActive() && isRealFrame;
+  bool shouldCountHostEvents = perfcount_isActive() && isRealFrame;
+  bool shouldRecordTimeline = timeline_isActive() && isRealFrame;
+  uint32_t instructions = 0;
+  TIMER_BEGIN(TIMER_CPU);
+  timeline_begin("cpu", TIMELINE_TID_MAIN, false);
+  if (shouldCountHostEvents) {
+    perfcount_begin();
+  }
+
+  // perform desired number of cpu cycles per ms
+  while (cpuCycles < cyclesPerInterval) {
+    uint16_t pc = reg.pc;
+    int32_t cycles = cpuCycles;
+    if (shouldRecordFlight) {
+      nes_recordFlight(0);
+    }
+    if (shouldTrace) {
+      TraceRecord record;
+      record.cycles = frameCycleBase + cpuCycles;
+      mos6502_step(&record, &nes_finishedInstruction);
+      tracelog_write(&record);
+    } else if (CONFIG_CPU.shouldSkipIdleLoops) {
+      mos6502_step(NULL, &nes_finishedInstruction);
+      if (reg.pc <= pc && pc - reg.pc <= NES_IDLE_LOOP_SIZE) {
+        nes_skipIdleLoop(cyclesPerInterval);
+      }
+    } else {
+      mos6502_step(NULL, &nes_finishedInstruction);
+    }
+    instructions++;
+    if (isHeatmapActive) {
+      heatmap_count(HEATMAP_EXECUTE, pc);
+    }
+    if (isCodeDataLogging && pc >= 0x8000) {
+      cdl_markCode(pc, mos6502_instructionLength(memoryMap[pc]));
+    }
+    if (shouldRecordTimeline && memoryMap[pc] == 0x40) {
+      // RTI, the only way out of the NMI handler
+      timeline_end("nmi", TIMELINE_TID_INTERRUPT, true);
+    }
+    if (shouldProfile) {
+      // skipped idle iterations are charged to the branch that closes the loop
+      profile_record(pc, reg.pc, memoryMap[pc], cpuCycles - cycles);
+    }
+  }
+
+  if (shouldCountHostEvents) {
+    perfcount_end(instructions);
+  }
+  if (shouldProfile) {
+    profile_endFrame();
+  }
+  timeline_end("cpu", TIMELINE_TID_MAIN, false);
+  TIMER_END(TIMER_CPU);
+}
+
+void nes_recordFlight(uint8_t flags) {
+  // no decoding or operand reads, just what the CPU holds before the step
+  TraceRecord* record = flight_next();
+  record->cycles = frameCycleBase + cpuCycles;
+  record->pc = reg.pc;
+  record->addr = 0;
+  record->pointer = 0;
+  record->data[0] = memoryMap[reg.pc];
+  record->data[1] = memoryMap[(uint16_t)(reg.pc + 1)];
+  record->data[2] = memoryMap[(uint16_t)(reg.pc + 2)];
+  record->a = reg.a;
+  record->x = reg.x;
+  record->y = reg.y;
+  record->p = reg.p;
+  record->s = reg.s;
+  record->value = 0;
+  record->flags = flags | TRACE_FLAG_NO_OPERAND;
+}
+
+void nes_interruptNmi(void) {
+  if (flight_isActive() && !isRunningAhead) {
+    nes_recordFlight(TRACE_FLAG_NMI);
+  }
+  if (!isRunningAhead) {
+    // run-ahead restores frameCount, so its interrupts would overlap real ones
+    timeline_begin("nmi", TIMELINE_TID_INTERRUPT, true);
+  }
+  mos6502_interrupt_nmi();
+  if (profile_isActive() && !isRunningAhead) {
+    profile_interrupt(reg.pc);
+  }
+}
+
+uint64_t nes_cycleCount(void) {
+  return ((uint64_t) frameCount * (CONFIG_CPU.frequency / INTERVALS_PER_SEC)) + cpuCycles;
+}
+
+void nes_dumpFlight(void) {
+  int count = flight_dump(FLIGHT_DUMP_PATH);
+  #if (!SUPPRESS_EXTIO)
+    if (count < 0) {
+      fprintf(stderr, "FLIGHT: unable to write %s\n", FLIGHT_DUMP_PATH);
+    } else {
+      fprintf(stderr, "FLIGHT: %d records written to %s\n", count, FLIGHT_DUMP_PATH);
+    }
+  #endif
+}
+
+void nes_skipIdleLoop(uint32_t cyclesPerInterval) {
+  // a loop that writes nothing and only reads memory without side effects
+  // repeats exactly until the PPU changes something the CPU can see
+  bool isRepeat = isIdleSafe && ppureg.ppustatus == idleLoop.ppustatus
+    && reg.pc == idleLoop.reg.pc && reg.a == idleLoop.reg.a && reg.x == idleLoop.reg.x
+    && reg.y == idleLoop.reg.y && reg.s == idleLoop.reg.s && reg.p == idleLoop.reg.p;
+
+  if (isRepeat) {
+    // skip whole iterations, stopping short of the next event and the end of the frame
+    int32_t iterationCycles = cpuCycles - idleLoop.cycles;
+    int32_t cycles = cyclesPerInterval - cpuCycles - 1;
+    int32_t ppuCycles = (nesppu_cyclesUntilEvent() - 1) / 3;
+    if (ppuCycles < cycles) {
+      cycles = ppuCycles;
+    }
+    int32_t iterations = cycles / iterationCycles;
+    if (iterations > 0) {
+      cpuCycles += iterations * iterationCycles;
+      nesppu_skip(iterations * iterationCycles * 3);
+    }
+  }
+
+  idleLoop.reg = reg;
+  idleLoop.ppustatus = ppureg.ppustatus;
+  idleLoop.cycles = cpuCycles;
+  isIdleSafe = true;
+}
+
+void nes_runAhead(uint32_t cyclesPerInterval) {
+  nes_saveState(&runAheadState);
+
+  // emulate ahead with the current input, drawing only the last frame
+  isRunningAhead = true;
+  for (int i = 1; i <= CONFIG_RUNAHEAD.frames; i++) {
+    nesppu_setRenderSkip(i < CONFIG_RUNAHEAD.frames);
+    cpuCycles -= cyclesPerInterval;
+    nes_runFrame(cyclesPerInterval, false);
+  }
+  isRunningAhead = false;
+
+  // BITMAP0 keeps the predicted frame while the machine goes back
+  nes_loadState(&runAheadState);
+  nesppu_setRenderSkip(true);
+}
+
 void nes_finishedInstruction(uint8_t cycles) {
   if (cycles == 0) {
     io_panic("Illegal instruction.");
@@ -133,7 +493,9 @@ void nes_finishedInstruction(uint8_t cycles) {
     }
     resetPPUStat = false;
   }
-  nesppu_step(cycles * 3, &mos6502_interrupt_nmi);
+  TIMER_BEGIN(TIMER_PPU);
+  nesppu_step(cycles * 3, &nes_interruptNmi);
+  TIMER_END(TIMER_PPU);
 }
 
 void nes_configureMemory(void) {
@@ -151,6 +513,14 @@ void nes_configureMemory(void) {
 }
 
 uint8_t nes_cpuRead(uint16_t addr) {
+  if (isHeatmapActive) {
+    heatmap_count(HEATMAP_READ, addr);
+  }
+  // the fetch of the current instruction reads its own bytes, which are code
+  if (isCodeDataLogging && addr >= 0x8000 && (uint16_t) (addr - reg.pc) >= 3) {
+    cdl_markData(addr);
+  }
+
   // handle special case of reading from ppustat
   if (addr >= 0x2000 && addr <= 0x3FFF) {
     addr = 0x2000 + (addr % 0x08);
@@ -160,6 +530,7 @@ uint8_t nes_cpuRead(uint16_t addr) {
     } else if (addr == 0x2004) {
       return oam[ppureg.oamaddr];
     } else if (addr == 0x2007) {
+      isIdleSafe = false;
       // PPUDATA reads should be buffered
       if (ppureg.loadedAddr >= 0x3F00) {
         uint8_t data = nesppu_read(ppureg.loadedAddr);
@@ -173,13 +544,35 @@ uint8_t nes_cpuRead(uint16_t addr) {
     }
   } else if (addr <= 0x4017) {
     if (addr == 0x4016) {
+      isIdleSafe = false;
       return nesjoypad_get();
     }
   }
   return memoryMap[addr];
 }
 
+uint8_t nes_cpuPeek(uint16_t addr) {
+  // what nes_cpuRead would return, without touching the PPU, joypad or logs
+  if (addr >= 0x2000 && addr <= 0x3FFF) {
+    addr = 0x2000 + (addr % 0x08);
+    if (addr == 0x2002) {
+      return ppureg.ppustatus;
+    } else if (addr == 0x2004) {
+      return oam[ppureg.oamaddr];
+    } else if (addr == 0x2007) {
+      return (ppureg.loadedAddr >= 0x3F00) ? nesppu_read(ppureg.loadedAddr) : ppureg.ppuDataBuffer;
+    }
+  } else if (addr == 0x4016) {
+    return nesjoypad_peek();
+  }
+  return memoryMap[addr];
+}
+
 void nes_cpuWrite(uint16_t addr, uint8_t data) {
+  isIdleSafe = false;
+  if (isHeatmapActive) {
+    heatmap_count(HEATMAP_WRITE, addr);
+  }
   if (addr <= 0x1FFF) {
     addr = addr % 0x0800;
     memoryMap[addr] = data;
@@ -233,6 +626,9 @@ void nes_cpuWrite(uint16_t addr, uint8_t data) {
   } else if (addr <= 0x4017) {
     if (addr == 0x4014) {
       ppureg.oamdma = data;
+      if (!isRunningAhead) {
+        timeline_instant("oam dma");
+      }
       uint16_t cpuAddr = ((uint16_t)data) << 8;
       for (int i = 0; i < 256; i++) {
         oam[i] = memoryMap[cpuAddr + i];
@@ -268,22 +664,151 @@ void nes_toggleJoypad(Keyboard key, int status) {
     nesjoypad_set(NJP_A, enabled);
   } else if (key == K_L) {
     nesjoypad_set(NJP_B, enabled);
+  } else if (key == K_BACKSP) {
+    // without a history the frame would run as usual, but unrecorded
+    isRewinding = enabled && rewind_isActive();
+  } else if (key == K_TAB) {
+    isFastForwarding = enabled;
+  } else if (key == K_F3 && enabled && CONFIG_DEBUG.shouldDisplayDebugScreen) {
+    if (!heatmap_setActive(!isHeatmapActive)) {
+      io_panic("Unable to allocate heatmap.");
+    }
+    if (!isHeatmapActive) {
+      memset(BITMAP1, 0, sizeof(uint32_t) * CONFIG_DISPLAY.width * CONFIG_DISPLAY.height);
+    }
+  } else if (key == K_F2 && enabled && flight_isActive()) {
+    nes_dumpFlight();
+  } else if (key == K_F5 && enabled) {
+    if (!nes_saveStateToFile(NES_QUICKSAVE_PATH)) {
+      io_panic("Unable to write save state.");
+    }
+  } else if (key == K_F9 && enabled) {
+    nes_loadStateFromFile(NES_QUICKSAVE_PATH);
+  }
+}
+
+void nes_saveState(NESState* state) {
+  state->magic = NES_STATE_MAGIC;
+  state->version = NES_STATE_VERSION;
+  state->size = sizeof(NESState);
+  state->frame = frameCount;
+  state->cpu = reg;
+  state->cpuCycles = cpuCycles;
+  state->resetPPUStat = resetPPUStat;
+
+  // everything else in memoryMap is ROM or a mirror of these
+  memcpy(state->ram, memoryMap, sizeof(state->ram));
+  memcpy(state->ppuIO, memoryMap + 0x2000, sizeof(state->ppuIO));
+  memcpy(state->apuIO, memoryMap + 0x4000, sizeof(state->apuIO));
+
+  nesppu_saveState(&state->ppu);
+  nesjoypad_saveState(&state->joypad);
+}
+
+bool nes_loadState(NESState* state) {
+  if (state->magic != NES_STATE_MAGIC || state->version != NES_STATE_VERSION || state->size != sizeof(NESState)) {
+    return false;
+  }
+
+  frameCount = state->frame;
+  reg = state->cpu;
+  cpuCycles = state->cpuCycles;
+  resetPPUStat = state->resetPPUStat;
+
+  for (uint16_t addr = 0x0000; addr < 0x2000; addr += sizeof(state->ram)) {
+    memcpy(memoryMap + addr, state->ram, sizeof(state->ram));
+  }
+  for (uint16_t addr = 0x2000; addr < 0x4000; addr += sizeof(state->ppuIO)) {
+    memcpy(memoryMap + addr, state->ppuIO, sizeof(state->ppuIO));
+  }
+  memcpy(memoryMap + 0x4000, state->apuIO, sizeof(state->apuIO));
+
+  nesppu_loadState(&state->ppu);
+  nesjoypad_loadState(&state->joypad);
+  return true;
+}
+
+bool nes_rewindFrame(void) {
+  if (!rewind_pop((uint8_t*) &frameState)) {
+    return false;
+  }
+
+  nes_loadState(&frameState);
+
+  // the frame is normally drawn at scanline 0, so redraw it from the restored state
+  nesppu_drawBackground();
+  nesppu_drawSprites(true);
+  return true;
+}
+
+uint64_t nes_hashFrame(void) {
+  // hash fields individually so struct padding can't leak in
+  uint8_t cpu[7] = {reg.a, reg.x, reg.y, reg.s, reg.p, reg.pc & 0xFF, reg.pc >> 8};
+  uint64_t hash = hash_compute(cpu, sizeof(cpu), 0);
+  hash = hash_compute(memoryMap, 0x800, hash);
+  hash = nesppu_hashState(hash);
+  return hash_compute((uint8_t*) BITMAP0, sizeof(uint32_t) * DISPLAY_PIXELS, hash);
+}
+
+void nes_checkFrameHash(void) {
+  uint64_t hash = nes_hashFrame();
+  if (!hash_recordFrame(frameCount, hash)) {
+    io_panic("Unable to record hash log.");
+  }
+
+  if (!hash_checkFrame(frameCount, hash)) {
+    #if (!SUPPRESS_EXTIO)
+      fprintf(stderr, "HASH: first divergence at frame %u (expected %016llX, got %016llX)\n",
+        frameCount, (unsigned long long) hash_expectedFrame(frameCount), (unsigned long long) hash);
+    #endif
+    io_panic("State diverged from hash log.");
+  }
+}
+
+bool nes_saveStateToFile(char* path) {
+  static NESState state;
+  nes_saveState(&state);
+  return fileio_writeBinaryToFile(path, &state, sizeof(NESState)) != -1;
+}
+
+bool nes_loadStateFromFile(char* path) {
+  uint8_t* data;
+  int size = fileio_readFileAsBinary(path, &data);
+  if (size == -1) {
+    return false;
+  }
+
+  // reject anything that isn't exactly one state from this build
+  bool didLoad = false;
+  if (size == sizeof(NESState)) {
+    didLoad = nes_loadState((NESState*) data);
   }
+  free(data);
+  return didLoad;
 }
 
 void nes_disassemble(char* filePath) {
   if (cartridge.header.mapperNumber == 0) {
     char assemblyLineString[64];
-    uint8_t bytecodeCount = 0;
+    Bytecode bytecode;
     uint32_t pc = 0x8000;
     uint32_t prgEnd = pc + (0x4000 * cartridge.header.prgRomSize);
     fileio_writeStringToFile(filePath, "", false);
     while (pc < prgEnd) {
       assemblyLineString[0] = '\0';
-      mos6502_decode_external_wrapper(NULL, assemblyLineString, &bytecodeCount, pc);
+      uint8_t flags = cdl_flags(pc);
+      if ((flags & (CDL_CODE | CDL_DATA)) == CDL_DATA) {
+        // only ever read, so decoding it would misalign the code after it
+        sprintf(assemblyLineString, "%*s $%02X\n", 4, ".byte", memoryMap[pc]);
+        fileio_writeStringToFile(filePath, assemblyLineString, true);
+        pc += 1;
+        continue;
+      }
+      mos6502_decode_external_wrapper(&bytecode, pc);
+      mos6502_formatBytecode(&bytecode, pc, assemblyLineString);
       strcat(assemblyLineString, "\n");
       fileio_writeStringToFile(filePath, assemblyLineString, true);
-      pc += bytecodeCount;
+      pc += bytecode.count;
     }
   }
 }
@@ -308,6 +833,19 @@ void nes_generateMetrics(char* outputStr) {
         strcat(outputStr, perfString);
       }
 
+      if (capture_isActive()) {
+        char captureString[64];
+        sprintf(captureString, "REC (%u dropped)\n\n", capture_droppedFrames());
+        strcat(outputStr, captureString);
+      }
+
+      #if (TIMER_ACTIVE)
+        char timerString[384];
+        timer_format(timerString);
+        strcat(outputStr, timerString);
+        strcat(outputStr, "\n");
+      #endif
+
       if (CONFIG_DEBUG.shouldDisplayDebugScreen) {
         strcat(outputStr, regString);
       }
@@ -318,6 +856,7 @@ void nes_generateMetrics(char* outputStr) {
 }
 
 void nes_debugCPU(void) {
+  TraceRecord record;
   char traceStr[256];
   char fileStr[256];
   char* correctStr;
@@ -330,7 +869,8 @@ void nes_debugCPU(void) {
 
   fileio_readFileAsString("./debug/nestest.log", &nestestLogData);
   fileio_writeStringToFile("./debug/nestest-gen.log", "", false);
-  mos6502_step(traceStr, &nes_finishedInstruction);
+  mos6502_step(&record, &nes_finishedInstruction);
+  mos6502_formatRecord(&record, traceStr);
   correctStr = strtok(nestestLogData, "\n");
 
   #if (!SUPPRESS_EXTIO)
@@ -340,7 +880,8 @@ void nes_debugCPU(void) {
   #endif
 
   while (strncmp(traceStr, correctStr, 73) == 0) {
-    mos6502_step(traceStr, &nes_finishedInstruction);
+    mos6502_step(&record, &nes_finishedInstruction);
+    mos6502_formatRecord(&record, traceStr);
     correctStr = strtok(NULL, "\n");
     lineNumber += 1;
 
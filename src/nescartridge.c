@@ -7,6 +7,16 @@
 
 #include "include/nescartridge.h"
 
+uint64_t nescartridge_hashRom(FileBinary* bin) {
+  // FNV-1a over the whole file, used to tie movies and states to a ROM
+  uint64_t hash = 0xCBF29CE484222325;
+  for (uint32_t i = 0; i < bin->bytes; i++) {
+    hash ^= bin->data[i];
+    hash *= 0x100000001B3;
+  }
+  return hash;
+}
+
 #if (SUPPRESS_EXTIO)
 #include FALLBACK_NES_ROM_HEADER
 
@@ -41,6 +51,7 @@ INES nescartridge_parseRom(FileBinary* bin) {
   header.prgRamSize = bin->data[8];
   header.tvSystem = (bin->data[9] & BIT_FILL_1) ? TV_PAL : TV_NTSC;
   cartridge.header = header;
+  cartridge.romHash = nescartridge_hashRom(bin);
 
   cartridge.prgRom = bin->data + 16;
   cartridge.chrRom = bin->data + 16 + 16384;
@@ -55,14 +66,19 @@ INES nescartridge_parseRom(FileBinary* bin) {
 #else
 
 INES nescartridge_loadRom(char* fsRoot) {
-  char selectedRomPath[FILEIO_MAX_NAME_SIZE];
+  char selectedRomPath[FILEIO_MAX_PATH_SIZE];
   selectedRomPath[0] = '\0';
-  strcat(selectedRomPath, fsRoot);
-  for (int i = 0; i < (CONFIG_DISPLAY.width * CONFIG_DISPLAY.height); i += 1) {
-    BITMAP0[i] = i;
+  strncat(selectedRomPath, fsRoot, FILEIO_MAX_PATH_SIZE - FILEIO_MAX_NAME_SIZE - 1);
+
+  // only show the selector if given a directory rather than a rom file
+  bool dasmMode = false;
+  if (!nescartridge_isRomFile(selectedRomPath)) {
+    for (int i = 0; i < (CONFIG_DISPLAY.width * CONFIG_DISPLAY.height); i += 1) {
+      BITMAP0[i] = i;
+    }
+    dasmMode = nescartridge_selectRom(selectedRomPath);
+    io_clear();
   }
-  bool dasmMode = nescartridge_selectRom(selectedRomPath);
-  io_clear();
 
   FileBinary bin;
   uint8_t* romBinary;
@@ -98,6 +114,7 @@ INES nescartridge_parseRom(FileBinary* bin) {
   header.prgRamSize = bin->data[8];
   header.tvSystem = (bin->data[9] & BIT_FILL_1) ? TV_PAL : TV_NTSC;
   cartridge.header = header;
+  cartridge.romHash = nescartridge_hashRom(bin);
   pos = 16;
 
   // load trainer, if present
@@ -151,39 +168,41 @@ bool nescartridge_selectRom(char selectedRomPath[FILEIO_MAX_PATH_SIZE]) {
 
   Keyboard key = K_ZERO;
   int selectedIndex = 0;
-  bool keyPressed = false;
   bool disassembleActivated = false;
-  while (key != K_RETURN) {
-    if (io_pollInput(&key) == 1) {
-      keyPressed = true;
-    } else if (io_pollInput(&key) == 0) {
-      keyPressed = false;
+  bool shouldRedraw = true;
+  while (true) {
+    if (shouldRedraw) {
+      outputMessage[0] = '\0';
+      strcat(outputMessage, "\n\tSelect a ROM:\n");
+
+      if (disassembleActivated) {
+        strcat(outputMessage, "\tCPU Mode: DASM\n");
+      } else {
+        strcat(outputMessage, "\tCPU Mode: EXEC\n");
+      }
+
+      for (int i = 0; i < romCount; i++) {
+        strcat(outputMessage, "\n\t[");
+        strcat(outputMessage, (selectedIndex == i) ? "*] " : " ] ");
+        strcat(outputMessage, romFiles[i]);
+      }
+      OVERLAY_MSG = outputMessage;
+      io_render();
     }
 
-    if (keyPressed && key == K_UP && selectedIndex > 0) {
+    // only redraw once a key press changes something
+    shouldRedraw = (io_waitInput(&key, IO_WAIT_TIMEOUT_MS) == 1);
+    if (!shouldRedraw) continue;
+
+    if (key == K_RETURN) {
+      break;
+    } else if (key == K_UP && selectedIndex > 0) {
       selectedIndex -= 1;
-    } else if (keyPressed && key == K_DOWN && selectedIndex < romCount - 1) {
+    } else if (key == K_DOWN && selectedIndex < romCount - 1) {
       selectedIndex += 1;
-    } else if (keyPressed && key == K_D) {
+    } else if (key == K_D) {
       disassembleActivated = !disassembleActivated;
     }
-
-    outputMessage[0] = '\0';
-    strcat(outputMessage, "\n\tSelect a ROM:\n");
-
-    if (disassembleActivated) {
-      strcat(outputMessage, "\tCPU Mode: DASM\n");
-    } else {
-      strcat(outputMessage, "\tCPU Mode: EXEC\n");
-    }
-
-    for (int i = 0; i < romCount; i++) {
-      strcat(outputMessage, "\n\t[");
-      strcat(outputMessage, (selectedIndex == i) ? "*] " : " ] ");
-      strcat(outputMessage, romFiles[i]);
-    }
-    OVERLAY_MSG = outputMessage;
-    io_render();
   }
 
   strncat(selectedRomPath, romFiles[selectedIndex], FILEIO_MAX_NAME_SIZE);
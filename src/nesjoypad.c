@@ -20,6 +20,11 @@ uint8_t nesjoypad_get(void) {
   return result;
 }
 
+uint8_t nesjoypad_peek(void) {
+  // the bit nesjoypad_get would return, without shifting
+  return (state >> ((shiftIndex > 7) ? 0 : shiftIndex)) & 1;
+}
+
 void nesjoypad_set(NESJoypadButton button, bool enabled) {
   if (enabled) {
     state |= button;
@@ -28,6 +33,26 @@ void nesjoypad_set(NESJoypadButton button, bool enabled) {
   }
 }
 
+uint8_t nesjoypad_getState(void) {
+  return state;
+}
+
+void nesjoypad_setState(uint8_t buttons) {
+  state = buttons;
+}
+
+void nesjoypad_saveState(NESJoypadState* joypad) {
+  joypad->buttons = state;
+  joypad->shiftIndex = shiftIndex;
+  joypad->strobeMode = strobeMode;
+}
+
+void nesjoypad_loadState(NESJoypadState* joypad) {
+  state = joypad->buttons;
+  shiftIndex = joypad->shiftIndex;
+  strobeMode = joypad->strobeMode;
+}
+
 void nesjoypad_setStrobeMode(bool mode) {
   strobeMode = mode;
   if (strobeMode) {
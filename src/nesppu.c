@@ -40,6 +40,7 @@ bool didGenerateNmi = false;
 int lastScanline = 0;
 bool shouldEdit[4];
 bool states[4];
+bool shouldSkipRender = false;
 
 void nesppu_init(INES* ines) {
   ppureg.ppuctrl = 0x00;
@@ -69,8 +70,16 @@ void nesppu_step(uint16_t cycles, void(*invoke_nmi)(void)) {
 
     if (scanline == 0) {
       didGenerateNmi = false;
+      TIMER_BEGIN(TIMER_BACKGROUND);
+      timeline_begin("background", TIMELINE_TID_MAIN, false);
       nesppu_drawBackground();
+      timeline_end("background", TIMELINE_TID_MAIN, false);
+      TIMER_END(TIMER_BACKGROUND);
+      TIMER_BEGIN(TIMER_SPRITES);
+      timeline_begin("sprites", TIMELINE_TID_MAIN, false);
       nesppu_drawSprites(true);
+      timeline_end("sprites", TIMELINE_TID_MAIN, false);
+      TIMER_END(TIMER_SPRITES);
     }
     
     if (scanline < 241) {
@@ -100,6 +109,8 @@ void nesppu_step(uint16_t cycles, void(*invoke_nmi)(void)) {
 }
 
 void nesppu_drawSprites(bool hasPriority) {
+  if (shouldSkipRender) return;
+
   for (int i = 0; i < 64; i++) {
     uint8_t byte0 = oam[i * 4];
     uint8_t byte1 = oam[(i * 4) + 1];
@@ -139,6 +150,8 @@ void nesppu_drawSprites(bool hasPriority) {
 }
 
 void nesppu_drawBackground(void) {
+  if (shouldSkipRender) return;
+
   uint16_t bankOffset = GET_ppuctrl_backgroundpattern(ppureg.ppuctrl) ? 256 : 0;
   for (int r = 0; r < 31; r++) {
     for (int c = 0; c < 33; c++) {
@@ -280,6 +293,70 @@ void nesppu_write(uint16_t addr, uint8_t data) {
   }
 }
 
+uint32_t nesppu_cyclesUntilEvent(void) {
+  // distance to the next scanline on which nesppu_step() changes anything the
+  // CPU can observe
+  bool isNmiPending = GET_ppustat_vblankstarted(ppureg.ppustatus) && GET_ppuctrl_generatenmi(ppureg.ppuctrl) && !didGenerateNmi;
+  for (uint32_t scanline = (cycleCount / 341) + 1; scanline < 261; scanline++) {
+    if (scanline == 241 || (scanline < 241 && scanline == oam[0]) || (scanline > 241 && isNmiPending)) {
+      return (scanline * 341) - cycleCount;
+    }
+  }
+
+  // scanline 261 and the wrap to the next frame are always left to nesppu_step()
+  return (cycleCount < 261 * 341) ? (261 * 341) - cycleCount : 1;
+}
+
+void nesppu_skip(uint32_t cycles) {
+  // only valid for fewer cycles than nesppu_cyclesUntilEvent(), so passing a
+  // scanline does nothing but record the unchanged registers
+  cycleCount += cycles;
+  while (lastScanline < cycleCount / 341) {
+    lastScanline += 1;
+    scanlineReg[lastScanline] = ppureg;
+  }
+}
+
+void nesppu_setRenderSkip(bool shouldSkip) {
+  // frames which will never be shown don't need to be drawn
+  shouldSkipRender = shouldSkip;
+}
+
+void nesppu_saveState(NESPPUState* state) {
+  // pattern tables come from CHR ROM and the bitmaps are redrawn every
+  // frame, so only registers and PPU RAM need to be kept
+  state->reg = ppureg;
+  memcpy(state->scanlineReg, scanlineReg, sizeof(scanlineReg));
+  memcpy(state->nametable, nametable, sizeof(nametable));
+  memcpy(state->attrTable, attrTable, sizeof(attrTable));
+  memcpy(state->vram, ppuMemoryMap + 0x2000, sizeof(state->vram));
+  memcpy(state->palette, ppuMemoryMap + 0x3F00, sizeof(state->palette));
+  memcpy(state->oam, oam, sizeof(oam));
+  state->cycleCount = cycleCount;
+  state->lastScanline = lastScanline;
+  state->didGenerateNmi = didGenerateNmi;
+}
+
+void nesppu_loadState(NESPPUState* state) {
+  ppureg = state->reg;
+  memcpy(scanlineReg, state->scanlineReg, sizeof(scanlineReg));
+  memcpy(nametable, state->nametable, sizeof(nametable));
+  memcpy(attrTable, state->attrTable, sizeof(attrTable));
+  memcpy(ppuMemoryMap + 0x2000, state->vram, sizeof(state->vram));
+  memcpy(ppuMemoryMap + 0x3F00, state->palette, sizeof(state->palette));
+  memcpy(oam, state->oam, sizeof(oam));
+  cycleCount = state->cycleCount;
+  lastScanline = state->lastScanline;
+  didGenerateNmi = state->didGenerateNmi;
+}
+
+uint64_t nesppu_hashState(uint64_t seed) {
+  uint64_t hash = hash_compute(&nametable[0][0], sizeof(nametable), seed);
+  hash = hash_compute(&attrTable[0][0], sizeof(attrTable), hash);
+  hash = hash_compute(paletteTable, 0x20, hash);
+  return hash_compute(oam, sizeof(oam), hash);
+}
+
 void nesppu_drawDebugData(void) {
   uint16_t bankOffset = GET_ppuctrl_backgroundpattern(ppureg.ppuctrl) ? 256 : 0;
 
@@ -0,0 +1,97 @@
+/**
+ * nesshm.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/nesshm.h"
+
+#if (SUPPRESS_EXTIO)
+
+bool nesshm_init(char* name) {
+  return false;
+}
+
+void nesshm_publishFrame(uint32_t frame, uint8_t* ram, uint32_t* bmp) {}
+
+void nesshm_applyInput(void) {}
+
+void nesshm_release(void) {}
+
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+NESSharedMemory* shm = NULL;
+char shmName[FILEIO_MAX_PATH_SIZE];
+
+bool nesshm_init(char* name) {
+  int fd = shm_open(name, O_CREAT | O_RDWR, 0600);
+  if (fd == -1) return false;
+
+  if (ftruncate(fd, sizeof(NESSharedMemory)) == -1) {
+    close(fd);
+    shm_unlink(name);
+    return false;
+  }
+
+  shm = mmap(NULL, sizeof(NESSharedMemory), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (shm == MAP_FAILED) {
+    shm = NULL;
+    shm_unlink(name);
+    return false;
+  }
+
+  strncpy(shmName, name, FILEIO_MAX_PATH_SIZE - 1);
+  shmName[FILEIO_MAX_PATH_SIZE - 1] = '\0';
+
+  memset(shm, 0, sizeof(NESSharedMemory));
+  shm->magic = NESSHM_MAGIC;
+  shm->version = NESSHM_VERSION;
+  shm->width = 256;
+  shm->height = 240;
+  atomic_init(&shm->sequence, 0);
+  atomic_init(&shm->input, 0);
+  atomic_init(&shm->inputEnabled, 0);
+
+  atexit(&nesshm_release);
+  return true;
+}
+
+void nesshm_publishFrame(uint32_t frame, uint8_t* ram, uint32_t* bmp) {
+  if (shm == NULL) return;
+
+  // odd sequence tells readers a write is in progress
+  unsigned int seq = atomic_load_explicit(&shm->sequence, memory_order_relaxed);
+  atomic_store_explicit(&shm->sequence, seq + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+
+  shm->frame = frame;
+  shm->joypad = nesjoypad_getState();
+  memcpy(shm->ram, ram, NESSHM_RAM_SIZE);
+  memcpy(shm->framebuffer, bmp, sizeof(uint32_t) * DISPLAY_PIXELS);
+
+  atomic_store_explicit(&shm->sequence, seq + 2, memory_order_release);
+}
+
+void nesshm_applyInput(void) {
+  if (shm == NULL) return;
+
+  if (atomic_load_explicit(&shm->inputEnabled, memory_order_acquire)) {
+    nesjoypad_setState(atomic_load_explicit(&shm->input, memory_order_relaxed));
+  }
+}
+
+void nesshm_release(void) {
+  if (shm == NULL) return;
+
+  munmap(shm, sizeof(NESSharedMemory));
+  shm_unlink(shmName);
+  shm = NULL;
+}
+
+#endif
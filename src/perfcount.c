@@ -0,0 +1,134 @@
+/**
+ * perfcount.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/perfcount.h"
+
+#if (!PERFCOUNT_SUPPORTED)
+
+bool perfcount_init(void) {
+  return false;
+}
+
+void perfcount_begin(void) {}
+void perfcount_end(uint32_t instructions) {}
+
+bool perfcount_isActive(void) {
+  return false;
+}
+
+void perfcount_finish(void) {}
+
+#else
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+char* perfCounterNames[PERFCOUNT_COUNT] = { "instructions", "cycles", "branch-misses", "L1D-misses" };
+int perfFds[PERFCOUNT_COUNT] = { -1, -1, -1, -1 };
+bool isPerfActive = false;
+uint64_t perfFrames = 0;
+uint64_t perfGuestInstructions = 0;
+
+int perfcount_open(uint32_t type, uint64_t config) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  // the emulator itself, which also keeps it usable with perf_event_paranoid = 2
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+bool perfcount_init(void) {
+  static const uint32_t types[PERFCOUNT_COUNT] = {
+    [PERFCOUNT_INSTRUCTIONS] = PERF_TYPE_HARDWARE,
+    [PERFCOUNT_CYCLES] = PERF_TYPE_HARDWARE,
+    [PERFCOUNT_BRANCH_MISSES] = PERF_TYPE_HARDWARE,
+    [PERFCOUNT_L1D_MISSES] = PERF_TYPE_HW_CACHE
+  };
+  static const uint64_t configs[PERFCOUNT_COUNT] = {
+    [PERFCOUNT_INSTRUCTIONS] = PERF_COUNT_HW_INSTRUCTIONS,
+    [PERFCOUNT_CYCLES] = PERF_COUNT_HW_CPU_CYCLES,
+    [PERFCOUNT_BRANCH_MISSES] = PERF_COUNT_HW_BRANCH_MISSES,
+    [PERFCOUNT_L1D_MISSES] = PERF_COUNT_HW_CACHE_L1D
+      | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+  };
+
+  for (int i = 0; i < PERFCOUNT_COUNT; i++) {
+    // each counter can fail for its own reason, so report it before the next open
+    perfFds[i] = perfcount_open(types[i], configs[i]);
+    if (perfFds[i] < 0) {
+      fprintf(stderr, "PERF: %s unavailable (%s)\n", perfCounterNames[i], strerror(errno));
+    } else {
+      isPerfActive = true;
+    }
+  }
+
+  if (isPerfActive) {
+    atexit(&perfcount_finish);
+  }
+  return isPerfActive;
+}
+
+void perfcount_begin(void) {
+  for (int i = 0; i < PERFCOUNT_COUNT; i++) {
+    if (perfFds[i] >= 0) {
+      ioctl(perfFds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+void perfcount_end(uint32_t instructions) {
+  for (int i = 0; i < PERFCOUNT_COUNT; i++) {
+    if (perfFds[i] >= 0) {
+      ioctl(perfFds[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  perfFrames++;
+  perfGuestInstructions += instructions;
+}
+
+bool perfcount_isActive(void) {
+  return isPerfActive;
+}
+
+void perfcount_finish(void) {
+  double totals[PERFCOUNT_COUNT];
+  for (int i = 0; i < PERFCOUNT_COUNT; i++) {
+    // value, time enabled, time running
+    uint64_t data[3];
+    totals[i] = -1;
+    if (perfFds[i] < 0 || read(perfFds[i], data, sizeof(data)) != sizeof(data)) continue;
+
+    // scale up if the kernel had to multiplex the counter
+    totals[i] = (data[2] > 0) ? (double) data[0] * data[1] / data[2] : 0;
+    close(perfFds[i]);
+  }
+
+  double frames = (perfFrames > 0) ? perfFrames : 1;
+  double millions = (perfGuestInstructions > 0) ? perfGuestInstructions / 1000000.0 : 1;
+  fprintf(stderr, "PERF: %llu frames, %llu guest instructions\n",
+    (unsigned long long) perfFrames, (unsigned long long) perfGuestInstructions);
+  for (int i = 0; i < PERFCOUNT_COUNT; i++) {
+    if (totals[i] < 0) continue;
+    fprintf(stderr, "PERF: %-14s %14.0f per frame %14.0f per M guest instructions\n",
+      perfCounterNames[i], totals[i] / frames, totals[i] / millions);
+  }
+  if (totals[PERFCOUNT_INSTRUCTIONS] > 0 && totals[PERFCOUNT_CYCLES] > 0) {
+    fprintf(stderr, "PERF: %.2f host instructions per cycle\n",
+      totals[PERFCOUNT_INSTRUCTIONS] / totals[PERFCOUNT_CYCLES]);
+  }
+}
+
+#endif
@@ -0,0 +1,180 @@
+/**
+ * profile.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/profile.h"
+
+uint64_t* pcCounts = NULL;
+uint64_t* pcCycles = NULL;
+uint8_t* pcOpcodes = NULL;
+uint64_t* routineCalls = NULL;
+uint64_t* routineCycles = NULL;
+uint64_t opcodeCounts[256];
+uint64_t opcodeCycles[256];
+uint64_t profileCycles = 0;
+uint64_t profileInstructions = 0;
+uint32_t profileFrames = 0;
+ProfileFrame profileStack[PROFILE_STACK_SIZE];
+int profileDepth = 0;
+bool hasPendingInterrupt = false;
+uint16_t pendingInterrupt = 0;
+
+void profile_call(uint16_t addr) {
+  // deeper calls are still counted once they return to a tracked level
+  if (profileDepth < PROFILE_STACK_SIZE) {
+    profileStack[profileDepth].addr = addr;
+    profileStack[profileDepth].entryCycles = profileCycles;
+  }
+  profileDepth++;
+}
+
+void profile_return(void) {
+  // games that return without calling (RTS used as a jump) are ignored
+  if (profileDepth == 0) return;
+  profileDepth--;
+  if (profileDepth < PROFILE_STACK_SIZE) {
+    ProfileFrame* frame = profileStack + profileDepth;
+    routineCalls[frame->addr]++;
+    routineCycles[frame->addr] += profileCycles - frame->entryCycles;
+  }
+}
+
+bool profile_init(void) {
+  pcCounts = calloc(65536, sizeof(uint64_t));
+  pcCycles = calloc(65536, sizeof(uint64_t));
+  pcOpcodes = calloc(65536, sizeof(uint8_t));
+  routineCalls = calloc(65536, sizeof(uint64_t));
+  routineCycles = calloc(65536, sizeof(uint64_t));
+  if (pcCounts == NULL || pcCycles == NULL || pcOpcodes == NULL
+    || routineCalls == NULL || routineCycles == NULL) {
+    return false;
+  }
+  atexit(&profile_finish);
+  return true;
+}
+
+void profile_record(uint16_t pc, uint16_t nextPc, uint8_t opcode, uint32_t cycles) {
+  pcCounts[pc]++;
+  pcCycles[pc] += cycles;
+  pcOpcodes[pc] = opcode;
+  opcodeCounts[opcode]++;
+  opcodeCycles[opcode] += cycles;
+  profileCycles += cycles;
+  profileInstructions++;
+
+  if (opcode == 0x20) {
+    // JSR
+    profile_call(nextPc);
+  } else if (opcode == 0x60 || opcode == 0x40) {
+    // RTS, RTI
+    profile_return();
+  }
+
+  if (hasPendingInterrupt) {
+    hasPendingInterrupt = false;
+    profile_call(pendingInterrupt);
+  }
+}
+
+void profile_interrupt(uint16_t addr) {
+  hasPendingInterrupt = true;
+  pendingInterrupt = addr;
+}
+
+void profile_endFrame(void) {
+  profileFrames++;
+}
+
+bool profile_isActive(void) {
+  return pcCounts != NULL;
+}
+
+#if (SUPPRESS_EXTIO)
+
+void profile_finish(void) {}
+
+#else
+
+uint64_t* sortKeys = NULL;
+
+int profile_compareKeys(const void* a, const void* b) {
+  uint64_t keyA = sortKeys[*(uint32_t*)a];
+  uint64_t keyB = sortKeys[*(uint32_t*)b];
+  return (keyA < keyB) - (keyA > keyB);
+}
+
+// Indices of the nonzero entries of keys, largest first
+uint32_t profile_rank(uint64_t* keys, uint32_t count, uint32_t* ranked) {
+  uint32_t n = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    if (keys[i] > 0) {
+      ranked[n++] = i;
+    }
+  }
+  sortKeys = keys;
+  qsort(ranked, n, sizeof(uint32_t), &profile_compareKeys);
+  return n;
+}
+
+double profile_percent(uint64_t part, uint64_t total) {
+  return (total > 0) ? (100.0 * part) / total : 0.0;
+}
+
+void profile_finish(void) {
+  if (pcCounts == NULL) return;
+
+  FILE* fp = fopen(PROFILE_REPORT_PATH, "w");
+  if (fp == NULL) {
+    fprintf(stderr, "PROFILE: unable to write %s\n", PROFILE_REPORT_PATH);
+    return;
+  }
+
+  uint32_t* ranked = malloc(sizeof(uint32_t) * 65536);
+  if (ranked == NULL) {
+    fclose(fp);
+    fprintf(stderr, "PROFILE: unable to write %s\n", PROFILE_REPORT_PATH);
+    return;
+  }
+
+  uint32_t frames = (profileFrames > 0) ? profileFrames : 1;
+  fprintf(fp, "%u frames, %llu instructions, %llu cycles\n",
+    profileFrames, (unsigned long long) profileInstructions, (unsigned long long) profileCycles);
+
+  // inclusive of everything called from the routine
+  uint32_t n = profile_rank(routineCycles, 65536, ranked);
+  fprintf(fp, "\nHOTTEST ROUTINES\n%-6s %12s %14s %12s %7s\n", "ADDR", "CALLS", "CYCLES", "CYC/FRAME", "%");
+  for (uint32_t i = 0; i < n && i < PROFILE_REPORT_ROWS; i++) {
+    uint32_t addr = ranked[i];
+    fprintf(fp, "$%04X  %12llu %14llu %12.1f %6.2f%%\n", addr,
+      (unsigned long long) routineCalls[addr], (unsigned long long) routineCycles[addr],
+      (double) routineCycles[addr] / frames, profile_percent(routineCycles[addr], profileCycles));
+  }
+
+  n = profile_rank(pcCycles, 65536, ranked);
+  fprintf(fp, "\nHOTTEST INSTRUCTIONS\n%-6s %-4s %12s %14s %12s %7s\n", "ADDR", "OP", "COUNT", "CYCLES", "CYC/FRAME", "%");
+  for (uint32_t i = 0; i < n && i < PROFILE_REPORT_ROWS; i++) {
+    uint32_t addr = ranked[i];
+    fprintf(fp, "$%04X  %-4s %12llu %14llu %12.1f %6.2f%%\n", addr, mos6502_mnemonicName(pcOpcodes[addr]),
+      (unsigned long long) pcCounts[addr], (unsigned long long) pcCycles[addr],
+      (double) pcCycles[addr] / frames, profile_percent(pcCycles[addr], profileCycles));
+  }
+
+  n = profile_rank(opcodeCounts, 256, ranked);
+  fprintf(fp, "\nOPCODE MIX\n%-4s %-4s %14s %7s %14s %7s\n", "OP", "", "COUNT", "%", "CYCLES", "%");
+  for (uint32_t i = 0; i < n; i++) {
+    uint32_t opcode = ranked[i];
+    fprintf(fp, "$%02X  %-4s %14llu %6.2f%% %14llu %6.2f%%\n", opcode, mos6502_mnemonicName(opcode),
+      (unsigned long long) opcodeCounts[opcode], profile_percent(opcodeCounts[opcode], profileInstructions),
+      (unsigned long long) opcodeCycles[opcode], profile_percent(opcodeCycles[opcode], profileCycles));
+  }
+
+  fclose(fp);
+  free(ranked);
+  fprintf(stderr, "PROFILE: %llu instructions profiled, report in %s\n",
+    (unsigned long long) profileInstructions, PROFILE_REPORT_PATH);
+}
+
+#endif
@@ -0,0 +1,173 @@
+/**
+ * rewind.c
+ * 
+ * Only the newest snapshot is kept whole. Every other frame is an entry of
+ * run-length encoded XOR deltas, so applying an entry to the newest snapshot
+ * yields the one before it. Entries are framed by their length on both ends
+ * so the ring can be walked backwards from the head and forwards from the tail.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/rewind.h"
+
+uint8_t* rewindRing = NULL;
+size_t rewindCapacity = 0;
+size_t rewindHead = 0;
+size_t rewindTail = 0;
+size_t rewindUsed = 0;
+uint32_t rewindEntries = 0;
+
+uint8_t* rewindCurrent = NULL;
+uint8_t* rewindScratch = NULL;
+size_t rewindStateSize = 0;
+bool rewindHasCurrent = false;
+
+bool rewind_init(size_t stateSize, size_t bufferSize) {
+  rewindStateSize = stateSize;
+  rewindCapacity = bufferSize;
+  rewindRing = malloc(bufferSize);
+  rewindCurrent = malloc(stateSize);
+
+  // worst case is a 4 byte header for every REWIND_MIN_ZERO_RUN + 1 bytes
+  rewindScratch = malloc((stateSize * 2) + 8);
+
+  return rewindRing != NULL && rewindCurrent != NULL && rewindScratch != NULL;
+}
+
+bool rewind_isActive(void) {
+  return rewindRing != NULL;
+}
+
+uint32_t rewind_frameCount(void) {
+  return rewindEntries;
+}
+
+void rewind_ringWrite(size_t pos, uint8_t* data, size_t size) {
+  size_t first = (size < rewindCapacity - pos) ? size : rewindCapacity - pos;
+  memcpy(rewindRing + pos, data, first);
+  memcpy(rewindRing, data + first, size - first);
+}
+
+void rewind_ringRead(size_t pos, uint8_t* data, size_t size) {
+  size_t first = (size < rewindCapacity - pos) ? size : rewindCapacity - pos;
+  memcpy(data, rewindRing + pos, first);
+  memcpy(data + first, rewindRing, size - first);
+}
+
+size_t rewind_encode(uint8_t* state) {
+  // [zero count:16][literal count:16][literal bytes] repeated
+  size_t out = 0;
+  size_t i = 0;
+
+  while (i < rewindStateSize) {
+    size_t zeros = 0;
+    while (i < rewindStateSize && zeros < 0xFFFF && (state[i] ^ rewindCurrent[i]) == 0) {
+      zeros += 1;
+      i += 1;
+    }
+
+    size_t literalStart = i;
+    size_t literals = 0;
+    size_t pendingZeros = 0;
+    while (i < rewindStateSize && literals + pendingZeros < 0xFFFF && pendingZeros < REWIND_MIN_ZERO_RUN) {
+      if ((state[i] ^ rewindCurrent[i]) == 0) {
+        pendingZeros += 1;
+      } else {
+        literals += pendingZeros + 1;
+        pendingZeros = 0;
+      }
+      i += 1;
+    }
+    i -= pendingZeros;
+
+    if (literals == 0 && i >= rewindStateSize) break;
+
+    rewindScratch[out++] = zeros & 0xFF;
+    rewindScratch[out++] = zeros >> 8;
+    rewindScratch[out++] = literals & 0xFF;
+    rewindScratch[out++] = literals >> 8;
+    for (size_t j = 0; j < literals; j++) {
+      rewindScratch[out++] = state[literalStart + j] ^ rewindCurrent[literalStart + j];
+    }
+  }
+
+  return out;
+}
+
+void rewind_decode(size_t size) {
+  size_t in = 0;
+  size_t pos = 0;
+
+  while (in < size) {
+    size_t zeros = rewindScratch[in] | (rewindScratch[in + 1] << 8);
+    size_t literals = rewindScratch[in + 2] | (rewindScratch[in + 3] << 8);
+    in += 4;
+    pos += zeros;
+    for (size_t j = 0; j < literals; j++) {
+      rewindCurrent[pos++] ^= rewindScratch[in++];
+    }
+  }
+}
+
+void rewind_dropOldest(void) {
+  uint32_t size;
+  rewind_ringRead(rewindTail, (uint8_t*) &size, sizeof(size));
+  size_t entrySize = size + (sizeof(uint32_t) * 2);
+  rewindTail = (rewindTail + entrySize) % rewindCapacity;
+  rewindUsed -= entrySize;
+  rewindEntries -= 1;
+}
+
+void rewind_push(uint8_t* state) {
+  if (!rewindHasCurrent) {
+    memcpy(rewindCurrent, state, rewindStateSize);
+    rewindHasCurrent = true;
+    return;
+  }
+
+  uint32_t size = rewind_encode(state);
+  size_t entrySize = size + (sizeof(uint32_t) * 2);
+
+  // a delta which can never fit means the history can't continue past it
+  if (entrySize > rewindCapacity) {
+    rewindHead = rewindTail = rewindUsed = 0;
+    rewindEntries = 0;
+    memcpy(rewindCurrent, state, rewindStateSize);
+    return;
+  }
+
+  while (rewindUsed + entrySize > rewindCapacity) {
+    rewind_dropOldest();
+  }
+
+  rewind_ringWrite(rewindHead, (uint8_t*) &size, sizeof(size));
+  rewind_ringWrite((rewindHead + sizeof(size)) % rewindCapacity, rewindScratch, size);
+  rewind_ringWrite((rewindHead + sizeof(size) + size) % rewindCapacity, (uint8_t*) &size, sizeof(size));
+  rewindHead = (rewindHead + entrySize) % rewindCapacity;
+  rewindUsed += entrySize;
+  rewindEntries += 1;
+
+  memcpy(rewindCurrent, state, rewindStateSize);
+}
+
+bool rewind_pop(uint8_t* state) {
+  if (rewindEntries == 0) return false;
+
+  uint32_t size;
+  size_t trailer = (rewindHead + rewindCapacity - sizeof(size)) % rewindCapacity;
+  rewind_ringRead(trailer, (uint8_t*) &size, sizeof(size));
+  size_t entrySize = size + (sizeof(uint32_t) * 2);
+  size_t start = (rewindHead + rewindCapacity - entrySize) % rewindCapacity;
+
+  rewind_ringRead((start + sizeof(size)) % rewindCapacity, rewindScratch, size);
+  rewind_decode(size);
+
+  rewindHead = start;
+  rewindUsed -= entrySize;
+  rewindEntries -= 1;
+
+  memcpy(state, rewindCurrent, rewindStateSize);
+  return true;
+}
@@ -0,0 +1,95 @@
+/**
+ * timeline.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/timeline.h"
+
+#if (SUPPRESS_EXTIO || SUPPRESS_TIMING)
+
+bool timeline_open(char* path, long frequency, uint64_t(*cycle)(void)) {
+  return false;
+}
+
+void timeline_begin(char* name, int tid, bool isEmulated) {}
+void timeline_end(char* name, int tid, bool isEmulated) {}
+void timeline_instant(char* name) {}
+
+bool timeline_isActive(void) {
+  return false;
+}
+
+void timeline_finish(void) {}
+
+#else
+
+FILE* timelineFile = NULL;
+struct timeval timelineStart;
+double usPerCycle = 0;
+uint64_t(*timelineCycle)(void) = NULL;
+
+double timeline_hostUs(void) {
+  struct timeval now;
+  gettimeofday(&now, 0);
+  return ((now.tv_sec - timelineStart.tv_sec) * 1000000.0) + (now.tv_usec - timelineStart.tv_usec);
+}
+
+void timeline_write(char* name, char phase, int pid, int tid, double ts, uint64_t cycle) {
+  fprintf(timelineFile, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"args\":{\"cycle\":%llu}%s}",
+    name, phase, pid, tid, ts, (unsigned long long) cycle, (phase == 'i') ? ",\"s\":\"p\"" : "");
+}
+
+bool timeline_open(char* path, long frequency, uint64_t(*cycle)(void)) {
+  timelineFile = fopen(path, "w");
+  if (timelineFile == NULL) return false;
+
+  gettimeofday(&timelineStart, 0);
+  usPerCycle = 1000000.0 / frequency;
+  timelineCycle = cycle;
+
+  // metadata first, so every event after it can lead with a comma
+  fprintf(timelineFile, "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"host time\"}}", TIMELINE_PID_HOST);
+  fprintf(timelineFile, ",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"emulated time\"}}", TIMELINE_PID_EMULATED);
+  atexit(&timeline_finish);
+  return true;
+}
+
+void timeline_begin(char* name, int tid, bool isEmulated) {
+  if (timelineFile == NULL) return;
+  uint64_t cycle = timelineCycle();
+  timeline_write(name, 'B', TIMELINE_PID_HOST, tid, timeline_hostUs(), cycle);
+  if (isEmulated) {
+    timeline_write(name, 'B', TIMELINE_PID_EMULATED, tid, cycle * usPerCycle, cycle);
+  }
+}
+
+void timeline_end(char* name, int tid, bool isEmulated) {
+  if (timelineFile == NULL) return;
+  uint64_t cycle = timelineCycle();
+  timeline_write(name, 'E', TIMELINE_PID_HOST, tid, timeline_hostUs(), cycle);
+  if (isEmulated) {
+    timeline_write(name, 'E', TIMELINE_PID_EMULATED, tid, cycle * usPerCycle, cycle);
+  }
+}
+
+void timeline_instant(char* name) {
+  if (timelineFile == NULL) return;
+  uint64_t cycle = timelineCycle();
+  timeline_write(name, 'i', TIMELINE_PID_HOST, TIMELINE_TID_MAIN, timeline_hostUs(), cycle);
+  timeline_write(name, 'i', TIMELINE_PID_EMULATED, TIMELINE_TID_MAIN, cycle * usPerCycle, cycle);
+}
+
+bool timeline_isActive(void) {
+  return timelineFile != NULL;
+}
+
+void timeline_finish(void) {
+  if (timelineFile == NULL) return;
+  fprintf(timelineFile, "\n]\n");
+  fclose(timelineFile);
+  timelineFile = NULL;
+}
+
+#endif
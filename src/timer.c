@@ -0,0 +1,93 @@
+/**
+ * timer.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/timer.h"
+
+#if (TIMER_ACTIVE)
+
+char* timerNames[TIMER_COUNT] = { "CPU", " PPU", "  BG", "  SPR", "RENDER", "INPUT", "SLEEP" };
+uint64_t frameTicks[TIMER_COUNT];
+float timerHistory[TIMER_COUNT][TIMER_HISTORY];
+uint32_t timerHistoryIndex = 0;
+uint32_t timerHistoryCount = 0;
+double ticksPerUs = 1.0;
+
+void timer_init(void) {
+  // measure the clock against gettimeofday()
+  struct timeval start, end;
+  gettimeofday(&start, 0);
+  uint64_t startTicks = timer_now();
+  usleep(TIMER_CALIBRATION_US);
+  gettimeofday(&end, 0);
+  uint64_t elapsedTicks = timer_now() - startTicks;
+  int64_t elapsedUs = ((end.tv_sec - start.tv_sec) * 1000000) + end.tv_usec - start.tv_usec;
+  ticksPerUs = (elapsedUs > 0) ? (double) elapsedTicks / elapsedUs : 1.0;
+
+  memset(frameTicks, 0, sizeof(frameTicks));
+  timerHistoryIndex = 0;
+  timerHistoryCount = 0;
+  atexit(&timer_finish);
+}
+
+void timer_add(TimerSection section, uint64_t ticks) {
+  frameTicks[section] += ticks;
+}
+
+void timer_endFrame(void) {
+  for (int i = 0; i < TIMER_COUNT; i++) {
+    timerHistory[i][timerHistoryIndex] = frameTicks[i] / ticksPerUs;
+    frameTicks[i] = 0;
+  }
+  timerHistoryIndex = (timerHistoryIndex + 1) % TIMER_HISTORY;
+  if (timerHistoryCount < TIMER_HISTORY) {
+    timerHistoryCount++;
+  }
+}
+
+int timer_compareFloats(const void* a, const void* b) {
+  float valA = *(float*)a;
+  float valB = *(float*)b;
+  return (valA > valB) - (valA < valB);
+}
+
+void timer_stats(TimerSection section, float* min, float* avg, float* p99) {
+  static float sorted[TIMER_HISTORY];
+  *min = 0;
+  *avg = 0;
+  *p99 = 0;
+  if (timerHistoryCount == 0) return;
+
+  double sum = 0;
+  for (uint32_t i = 0; i < timerHistoryCount; i++) {
+    sorted[i] = timerHistory[section][i];
+    sum += sorted[i];
+  }
+  qsort(sorted, timerHistoryCount, sizeof(float), &timer_compareFloats);
+  *min = sorted[0];
+  *avg = sum / timerHistoryCount;
+  *p99 = sorted[((timerHistoryCount - 1) * 99) / 100];
+}
+
+void timer_format(char* str) {
+  float min, avg, p99;
+  str += sprintf(str, "us     %6s%6s%6s\n", "MIN", "AVG", "P99");
+  for (int i = 0; i < TIMER_COUNT; i++) {
+    timer_stats(i, &min, &avg, &p99);
+    str += sprintf(str, "%-7s%6.0f%6.0f%6.0f\n", timerNames[i], min, avg, p99);
+  }
+}
+
+void timer_finish(void) {
+  float min, avg, p99;
+  fprintf(stderr, "TIMER: us per frame over the last %u frames\n", timerHistoryCount);
+  for (int i = 0; i < TIMER_COUNT; i++) {
+    timer_stats(i, &min, &avg, &p99);
+    fprintf(stderr, "TIMER: %-7s min %8.1f  avg %8.1f  p99 %8.1f\n", timerNames[i], min, avg, p99);
+  }
+}
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * tracedecode.c
+ * 
+ * Convert a binary instruction trace back into the text trace format.
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "../include/tracelog.h"
+
+// mos6502.c reads these, but only the formatting tables are needed here
+CpuConfig CONFIG_CPU;
+DebugConfig CONFIG_DEBUG;
+
+uint8_t tracedecode_read(uint16_t addr) {
+  return 0;
+}
+
+void tracedecode_write(uint16_t addr, uint8_t data) {}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <trace.bin> [--cycles]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  bool shouldPrintCycles = (argc > 2 && !strcmp(argv[2], "--cycles"));
+
+  FILE* fp = fopen(argv[1], "rb");
+  if (fp == NULL) {
+    fprintf(stderr, "ERROR: Unable to read trace '%s'\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  TraceLogHeader header;
+  if (fread(&header, sizeof(TraceLogHeader), 1, fp) != 1 || header.magic != TRACELOG_MAGIC
+      || header.version != TRACELOG_VERSION || header.recordSize != sizeof(TraceRecord)) {
+    fprintf(stderr, "ERROR: '%s' is not a binary trace from this build\n", argv[1]);
+    fclose(fp);
+    return EXIT_FAILURE;
+  }
+
+  mos6502_init(&tracedecode_write, &tracedecode_read, &tracedecode_read);
+
+  static TraceRecord records[TRACELOG_BUFFER_RECORDS];
+  char trace[256];
+  size_t count;
+  while ((count = fread(records, sizeof(TraceRecord), TRACELOG_BUFFER_RECORDS, fp)) > 0) {
+    for (size_t i = 0; i < count; i++) {
+      mos6502_formatRecord(&records[i], trace);
+      if (shouldPrintCycles) {
+        printf("%s CYC:%llu\n", trace, (unsigned long long) records[i].cycles);
+      } else {
+        puts(trace);
+      }
+    }
+  }
+
+  fclose(fp);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+/**
+ * tracelog.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/tracelog.h"
+
+#if (SUPPRESS_EXTIO)
+
+bool tracelog_open(char* path, TraceFormat format) {
+  return false;
+}
+
+void tracelog_write(TraceRecord* record) {}
+
+void tracelog_finish(void) {}
+
+#else
+
+FILE* traceFile = NULL;
+TraceFormat traceFormat = TRACE_TEXT;
+TraceRecord* traceBuffer = NULL;
+uint32_t traceBufferCount = 0;
+uint64_t traceRecordCount = 0;
+
+void tracelog_flush(void) {
+  fwrite(traceBuffer, sizeof(TraceRecord), traceBufferCount, traceFile);
+  traceBufferCount = 0;
+}
+
+bool tracelog_open(char* path, TraceFormat format) {
+  traceFile = fopen(path, "wb");
+  if (traceFile == NULL) return false;
+  traceFormat = format;
+
+  if (format == TRACE_BINARY) {
+    traceBuffer = malloc(sizeof(TraceRecord) * TRACELOG_BUFFER_RECORDS);
+    if (traceBuffer == NULL) return false;
+
+    TraceLogHeader header;
+    header.magic = TRACELOG_MAGIC;
+    header.version = TRACELOG_VERSION;
+    header.recordSize = sizeof(TraceRecord);
+    header.reserved = 0;
+    fwrite(&header, sizeof(TraceLogHeader), 1, traceFile);
+  } else {
+    // lines are short, so let stdio gather them into large writes
+    setvbuf(traceFile, NULL, _IOFBF, TRACELOG_TEXT_BUFFER);
+  }
+
+  atexit(&tracelog_finish);
+  return true;
+}
+
+void tracelog_write(TraceRecord* record) {
+  traceRecordCount += 1;
+  if (traceFormat == TRACE_BINARY) {
+    traceBuffer[traceBufferCount] = *record;
+    traceBufferCount += 1;
+    if (traceBufferCount == TRACELOG_BUFFER_RECORDS) {
+      tracelog_flush();
+    }
+  } else {
+    char trace[256];
+    mos6502_formatRecord(record, trace);
+    fputs(trace, traceFile);
+    fputc('\n', traceFile);
+  }
+}
+
+void tracelog_finish(void) {
+  if (traceFile == NULL) return;
+
+  if (traceFormat == TRACE_BINARY) {
+    tracelog_flush();
+  }
+  fclose(traceFile);
+  traceFile = NULL;
+
+  fprintf(stderr, "TRACE: %llu instructions traced\n", (unsigned long long) traceRecordCount);
+}
+
+#endif
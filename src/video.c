@@ -0,0 +1,64 @@
+/**
+ * video.c
+ * 
+ * @author Noah Sadir
+ * @date 2026-10-19
+ */
+
+#include "include/video.h"
+
+#if (!SUPPRESS_EXTIO)
+
+uint32_t video_frameSize(VideoFormat format, int width, int height) {
+  if (format == VIDEO_Y4M) {
+    return 6 + (width * height * 3);
+  } else if (format == VIDEO_PPM) {
+    return video_ppmHeaderSize(width, height) + (width * height * 3);
+  }
+  return width * height * 3;
+}
+
+uint32_t video_encodeFrame(VideoFormat format, uint32_t* bmp, int width, int height, uint8_t* output) {
+  int pixelCount = width * height;
+
+  if (format == VIDEO_Y4M) {
+    // planar 4:4:4 YCbCr using integer BT.601 coefficients
+    memcpy(output, "FRAME\n", 6);
+    uint8_t* yPlane = output + 6;
+    uint8_t* uPlane = yPlane + pixelCount;
+    uint8_t* vPlane = uPlane + pixelCount;
+    for (int i = 0; i < pixelCount; i++) {
+      int r = (bmp[i] >> 16) & 0xFF;
+      int g = (bmp[i] >> 8) & 0xFF;
+      int b = bmp[i] & 0xFF;
+      yPlane[i] = (((66 * r) + (129 * g) + (25 * b) + 128) >> 8) + 16;
+      uPlane[i] = (((-38 * r) - (74 * g) + (112 * b) + 128) >> 8) + 128;
+      vPlane[i] = (((112 * r) - (94 * g) - (18 * b) + 128) >> 8) + 128;
+    }
+  } else {
+    // packed 24-bit RGB, preceded by a header for standalone PPM images
+    if (format == VIDEO_PPM) {
+      output += sprintf((char*)output, "P6\n%d %d\n255\n", width, height);
+    }
+    for (int i = 0; i < pixelCount; i++) {
+      output[(i * 3) + 0] = (bmp[i] >> 16) & 0xFF;
+      output[(i * 3) + 1] = (bmp[i] >> 8) & 0xFF;
+      output[(i * 3) + 2] = bmp[i] & 0xFF;
+    }
+  }
+
+  return video_frameSize(format, width, height);
+}
+
+uint32_t video_ppmHeaderSize(int width, int height) {
+  char header[32];
+  return sprintf(header, "P6\n%d %d\n255\n", width, height);
+}
+
+void video_writeStreamHeader(FILE* fp, VideoFormat format, int width, int height) {
+  if (format == VIDEO_Y4M) {
+    fprintf(fp, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", width, height, INTERVALS_PER_SEC);
+  }
+}
+
+#endif